@@ -974,6 +974,11 @@ extern "C" {
 
 #define GLFW_X11_CLASS_NAME         0x00024001
 #define GLFW_X11_INSTANCE_NAME      0x00024002
+#define GLFW_X11_SOFTWARE_SURFACE   0x00024003
+
+#define GLFW_DRM_BUFFER_COUNT       0x00025001
+#define GLFW_DRM_HEADLESS           0x00025002
+#define GLFW_DRM_ADAPTIVE_SYNC      0x00025003
 /*! @} */
 
 #define GLFW_NO_API                          0
@@ -992,6 +997,8 @@ extern "C" {
 #define GLFW_STICKY_KEYS            0x00033002
 #define GLFW_STICKY_MOUSE_BUTTONS   0x00033003
 #define GLFW_LOCK_KEY_MODS          0x00033004
+#define GLFW_COALESCE_EVENTS        0x00033005
+#define GLFW_CURSOR_HISTORY         0x00033006
 
 #define GLFW_CURSOR_NORMAL          0x00034001
 #define GLFW_CURSOR_HIDDEN          0x00034002
@@ -1048,12 +1055,35 @@ extern "C" {
 #define GLFW_CONNECTED              0x00040001
 #define GLFW_DISCONNECTED           0x00040002
 
+/*! @addtogroup window
+ *  @{ */
+/*! @brief The file descriptor can be read from without blocking.
+ *
+ *  The file descriptor can be read from without blocking.
+ */
+#define GLFW_FD_READABLE            0x0001
+/*! @brief The file descriptor can be written to without blocking.
+ *
+ *  The file descriptor can be written to without blocking.
+ */
+#define GLFW_FD_WRITABLE            0x0002
+/*! @brief The file descriptor has hung up or has an error condition.
+ *
+ *  The file descriptor has hung up or has an error condition.  This is
+ *  reported whether or not it was watched for.
+ */
+#define GLFW_FD_ERROR               0x0004
+/*! @} */
+
 /*! @addtogroup init
  *  @{ */
 #define GLFW_JOYSTICK_HAT_BUTTONS   0x00050001
 
 #define GLFW_COCOA_CHDIR_RESOURCES  0x00051001
 #define GLFW_COCOA_MENUBAR          0x00051002
+
+#define GLFW_DRM_DEVICE             0x00052001
+#define GLFW_DRM_RENDER_DEVICE      0x00052002
 /*! @} */
 
 #define GLFW_DONT_CARE              -1
@@ -1488,6 +1518,42 @@ typedef void (* GLFWmonitorfun)(GLFWmonitor*,int);
  */
 typedef void (* GLFWjoystickfun)(int,int);
 
+/*! @brief The function signature for file descriptor callbacks.
+ *
+ *  This is the function signature for file descriptor callback functions.
+ *
+ *  @param[in] fd The file descriptor that is ready.
+ *  @param[in] events A bit field of the `GLFW_FD_*` conditions that were met.
+ *  @param[in] pointer The user pointer passed to @ref glfwWatchFileDescriptor.
+ *
+ *  @sa @ref events_fd
+ *  @sa @ref glfwWatchFileDescriptor
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup window
+ */
+typedef void (* GLFWfdfun)(int,int,void*);
+
+/*! @brief The function signature for clipboard request callbacks.
+ *
+ *  This is the function signature for clipboard request callback functions.
+ *
+ *  @param[in] window The window that requested the clipboard contents.
+ *  @param[in] string The contents of the clipboard as a UTF-8 encoded string,
+ *  or `NULL` if the request failed, timed out or was cancelled.
+ *
+ *  @pointer_lifetime The string is valid only until the callback returns.
+ *
+ *  @sa @ref clipboard
+ *  @sa @ref glfwRequestClipboardString
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWclipboardfun)(GLFWwindow*,const char*);
+
 /*! @brief Video mode type.
  *
  *  This describes a single video mode.
@@ -3780,15 +3846,80 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout);
  */
 GLFWAPI void glfwPostEmptyEvent(void);
 
+/*! @brief Watches a file descriptor while waiting for events.
+ *
+ *  This function adds the specified file descriptor to those that GLFW polls
+ *  while waiting for events.  When it becomes ready, @ref glfwWaitEvents and
+ *  @ref glfwWaitEventsTimeout return and the callback is called with the
+ *  conditions that were met.  Ready file descriptors are also checked by @ref
+ *  glfwPollEvents.  This lets applications wake up on sockets, pipes and
+ *  timers without a separate thread calling @ref glfwPostEmptyEvent.
+ *
+ *  The callback must consume whatever made the file descriptor ready, or it
+ *  will be called again by the next event processing call.  Watching a file
+ *  descriptor again replaces its conditions, callback and user pointer.
+ *
+ *  At most 16 file descriptors can be watched at a time, including up to two
+ *  that GLFW watches itself.  Watching more than that fails with @ref
+ *  GLFW_OUT_OF_MEMORY.
+ *
+ *  @param[in] fd The file descriptor to watch.
+ *  @param[in] events A bit field of `GLFW_FD_READABLE` and `GLFW_FD_WRITABLE`.
+ *  @param[in] callback The function to call when the file descriptor is
+ *  ready.
+ *  @param[in] pointer The user pointer to pass to the callback.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_OUT_OF_MEMORY and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @win32 @macos File descriptors cannot be watched and this function
+ *  emits @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref events_fd
+ *  @sa @ref glfwUnwatchFileDescriptor
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwWatchFileDescriptor(int fd, int events, GLFWfdfun callback, void* pointer);
+
+/*! @brief Stops watching a file descriptor while waiting for events.
+ *
+ *  This function removes the specified file descriptor from those that GLFW
+ *  polls while waiting for events.  File descriptors must be removed before
+ *  they are closed.
+ *
+ *  @param[in] fd The file descriptor to stop watching.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref events_fd
+ *  @sa @ref glfwWatchFileDescriptor
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwUnwatchFileDescriptor(int fd);
+
 /*! @brief Returns the value of an input option for the specified window.
  *
  *  This function returns the value of an input option for the specified window.
  *  The mode must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
- *  @ref GLFW_STICKY_MOUSE_BUTTONS or @ref GLFW_LOCK_KEY_MODS.
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS,
+ *  @ref GLFW_COALESCE_EVENTS or @ref GLFW_CURSOR_HISTORY.
  *
  *  @param[in] window The window to query.
  *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
- *  `GLFW_STICKY_MOUSE_BUTTONS` or `GLFW_LOCK_KEY_MODS`.
+ *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS`, `GLFW_COALESCE_EVENTS`
+ *  or `GLFW_CURSOR_HISTORY`.
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_INVALID_ENUM.
@@ -3807,7 +3938,8 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
  *
  *  This function sets an input mode option for the specified window.  The mode
  *  must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
- *  @ref GLFW_STICKY_MOUSE_BUTTONS or @ref GLFW_LOCK_KEY_MODS.
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS,
+ *  @ref GLFW_COALESCE_EVENTS or @ref GLFW_CURSOR_HISTORY.
  *
  *  If the mode is `GLFW_CURSOR`, the value must be one of the following cursor
  *  modes:
@@ -3839,9 +3971,27 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
  *  GLFW_MOD_CAPS_LOCK bit set when the event was generated with Caps Lock on,
  *  and the @ref GLFW_MOD_NUM_LOCK bit when Num Lock was on.
  *
+ *  If the mode is `GLFW_COALESCE_EVENTS`, the value must be either `GLFW_TRUE`
+ *  to enable event coalescing, or `GLFW_FALSE` to disable it.  If enabled,
+ *  consecutive cursor motion, scroll, window size and framebuffer size events
+ *  of the same kind for the window are collapsed into a single callback,
+ *  delivered at the latest by the end of @ref glfwPollEvents, @ref
+ *  glfwWaitEvents or @ref glfwWaitEventsTimeout.  Scroll offsets are summed
+ *  and the other events report their latest value.  Events are only collapsed
+ *  into an earlier one if no collapsible event of another kind arrived in
+ *  between, and pending events are delivered before any other event of the
+ *  window, so callbacks are always called in the order the events arrived.
+ *  This is useful when handling high frequency pointing devices.
+ *
+ *  If the mode is `GLFW_CURSOR_HISTORY`, the value must be either `GLFW_TRUE`
+ *  to record the cursor positions dropped by event coalescing, or `GLFW_FALSE`
+ *  to discard them.  The recorded positions can be retrieved with @ref
+ *  glfwGetCursorHistory from the cursor position callback.
+ *
  *  @param[in] window The window whose input mode to set.
  *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
- *  `GLFW_STICKY_MOUSE_BUTTONS` or `GLFW_LOCK_KEY_MODS`.
+ *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS`, `GLFW_COALESCE_EVENTS`
+ *  or `GLFW_CURSOR_HISTORY`.
  *  @param[in] value The new value of the specified input mode.
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
@@ -4054,6 +4204,44 @@ GLFWAPI int glfwGetMouseButton(GLFWwindow* window, int button);
  */
 GLFWAPI void glfwGetCursorPos(GLFWwindow* window, double* xpos, double* ypos);
 
+/*! @brief Returns the cursor positions collapsed by event coalescing.
+ *
+ *  This function returns the cursor positions that were reported by the
+ *  platform but not delivered to the cursor position callback because the @ref
+ *  GLFW_COALESCE_EVENTS input mode collapsed them.  The positions are stored
+ *  as consecutive x- and y-coordinate pairs, oldest first, in the same
+ *  coordinate space as @ref glfwGetCursorPos.  The position passed to the
+ *  current or most recent cursor position callback is not included.
+ *
+ *  Positions are only recorded while the @ref GLFW_CURSOR_HISTORY input mode
+ *  is enabled.  If no positions were collapsed since the previous cursor
+ *  position callback, this function returns `NULL` and sets `count` to zero.
+ *
+ *  @param[in] window The window to query.
+ *  @param[out] count Where to store the number of positions in the returned
+ *  array.  This is set to zero if no positions were collapsed or an error
+ *  occurred.
+ *  @return An array of `2 * count` coordinates, or `NULL` if there are none or
+ *  an error occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @pointer_lifetime The returned array is allocated and freed by GLFW.  You
+ *  should not free it yourself.  It is valid until the next cursor position
+ *  event for the window is processed, the window is destroyed or the library is
+ *  terminated.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref cursor_history
+ *  @sa @ref glfwSetInputMode
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI const double* glfwGetCursorHistory(GLFWwindow* window, int* count);
+
 /*! @brief Sets the position of the cursor, relative to the client area of the
  *  window.
  *
@@ -4954,6 +5142,48 @@ GLFWAPI void glfwSetClipboardString(GLFWwindow* window, const char* string);
  */
 GLFWAPI const char* glfwGetClipboardString(GLFWwindow* window);
 
+/*! @brief Requests the contents of the clipboard without blocking.
+ *
+ *  This function starts retrieving the contents of the system clipboard and
+ *  returns immediately.  When the contents have been received and converted to
+ *  a UTF-8 encoded string, the specified callback is called from event
+ *  processing.  If the clipboard is empty, its contents cannot be converted or
+ *  the clipboard owner does not respond within the timeout, the callback is
+ *  called with `NULL` and an error is generated.
+ *
+ *  Only one request can be in progress at a time.  Starting another request or
+ *  calling @ref glfwGetClipboardString cancels the request in progress, whose
+ *  callback is then called with `NULL`.  If the window is destroyed before the
+ *  request completes, the callback is not called.
+ *
+ *  @param[in] window The window that will receive the result.
+ *  @param[in] cbfun The function to call with the result.
+ *  @param[in] timeout The maximum time, in seconds, to wait for the clipboard
+ *  owner to respond.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_FORMAT_UNAVAILABLE and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @x11 Large contents are received incrementally from the event loop
+ *  and the request times out if the clipboard owner stops responding.
+ *
+ *  @remark @win32 @macos The clipboard contents are retrieved immediately and
+ *  the callback is called before this function returns.
+ *
+ *  @remark @wayland Clipboard is currently unimplemented.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref clipboard
+ *  @sa @ref glfwGetClipboardString
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwRequestClipboardString(GLFWwindow* window, GLFWclipboardfun cbfun, double timeout);
+
 /*! @brief Returns the value of the GLFW timer.
  *
  *  This function returns the value of the GLFW timer.  Unless the timer has
@@ -63,6 +63,7 @@ extern "C" {
  *  * `GLFW_EXPOSE_NATIVE_X11`
  *  * `GLFW_EXPOSE_NATIVE_WAYLAND`
  *  * `GLFW_EXPOSE_NATIVE_MIR`
+ *  * `GLFW_EXPOSE_NATIVE_DRM`
  *
  *  The available context API macros are:
  *  * `GLFW_EXPOSE_NATIVE_WGL`
@@ -101,10 +102,13 @@ extern "C" {
 #elif defined(GLFW_EXPOSE_NATIVE_X11)
  #include <X11/Xlib.h>
  #include <X11/extensions/Xrandr.h>
+ #include <stdint.h>
 #elif defined(GLFW_EXPOSE_NATIVE_WAYLAND)
  #include <wayland-client.h>
 #elif defined(GLFW_EXPOSE_NATIVE_MIR)
  #include <mir_toolkit/mir_client_library.h>
+#elif defined(GLFW_EXPOSE_NATIVE_DRM)
+ #include <stdint.h>
 #endif
 
 #if defined(GLFW_EXPOSE_NATIVE_WGL)
@@ -293,6 +297,145 @@ GLFWAPI RROutput glfwGetX11Monitor(GLFWmonitor* monitor);
  */
 GLFWAPI Window glfwGetX11Window(GLFWwindow* window);
 
+/*! @brief Retrieves the cursor position from the X server.
+ *
+ *  This function queries the X server for the position of the cursor relative
+ *  to the client area of the specified window.  Unlike @ref glfwGetCursorPos,
+ *  which is served from pointer events already received where possible, this
+ *  always performs a round trip to the server.  It also updates the position
+ *  later returned by @ref glfwGetCursorPos when the cursor is not disabled.
+ *
+ *  @param[in] window The desired window.
+ *  @param[out] xpos Where to store the cursor x-coordinate, relative to the
+ *  left edge of the client area, or `NULL`.
+ *  @param[out] ypos Where to store the cursor y-coordinate, relative to the
+ *  top edge of the client area, or `NULL`.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref cursor_pos
+ *  @sa glfwGetCursorPos
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwQueryX11CursorPos(GLFWwindow* window, double* xpos, double* ypos);
+
+/*! @brief Retrieves the timing of the most recent frame of the window.
+ *
+ *  This function retrieves the media stream counter (MSC) and time at which
+ *  the most recent frame of the specified window reached the screen, as
+ *  reported by the Present extension, along with the number of vblanks that
+ *  frames have missed since the window was created.  A frame misses a vblank
+ *  if it reaches the screen later than the target MSC it was swapped for with
+ *  @ref glfwSwapGLXBuffersMsc or, for @ref glfwSwapBuffers, later than the
+ *  swap interval after the previous frame or the first vblank after the swap,
+ *  whichever comes last.
+ *
+ *  Any or all of the output parameters may be `NULL`.  If an error occurs or
+ *  no frame has reached the screen yet, all non-`NULL` output parameters will
+ *  be set to zero.
+ *
+ *  @param[in] window The window to query.
+ *  @param[out] msc Where to store the MSC of the most recent frame, or
+ *  `NULL`.
+ *  @param[out] time Where to store the time, in seconds, of the most recent
+ *  frame, in the time base of @ref glfwGetTime, or `NULL`.
+ *  @param[out] missed Where to store the number of missed vblanks, or `NULL`.
+ *  @return `GLFW_TRUE` if a frame has reached the screen, or `GLFW_FALSE`
+ *  otherwise.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark The values are updated as Present events are processed, which
+ *  happens during event processing.  Only windows with a context receive
+ *  these events, and only if both the server and the driver use the Present
+ *  extension.  Missed vblanks are only counted for GLX contexts whose driver
+ *  sends each swap with its swap buffer counter as the Present serial, as
+ *  DRI3 drivers do.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwGetX11FrameTiming(GLFWwindow* window, uint64_t* msc, double* time, uint64_t* missed);
+
+/*! @brief Returns the back buffer of the software surface of the window.
+ *
+ *  This function returns the buffer the application should draw the next frame
+ *  of the specified window into.  The window must have been created with the
+ *  [GLFW_X11_SOFTWARE_SURFACE](@ref GLFW_X11_SOFTWARE_SURFACE_hint) hint.
+ *  Pixels are 32-bit `0x00RRGGBB` values in host byte order.
+ *
+ *  The buffer is shared with the X server if the MIT-SHM extension is
+ *  available and holds the most recently presented frame.  If the server is
+ *  still reading from it, this function waits until it has finished.  The
+ *  buffer is reallocated with undefined contents when the window has been
+ *  resized.
+ *
+ *  @param[in] window The window whose buffer to retrieve.
+ *  @param[out] width Where to store the width, in pixels, of the buffer, or
+ *  `NULL`.
+ *  @param[out] height Where to store the height, in pixels, of the buffer, or
+ *  `NULL`.
+ *  @param[out] stride Where to store the distance, in bytes, between the
+ *  starts of consecutive rows, or `NULL`.
+ *  @return The pixels of the buffer, or `NULL` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_OUT_OF_MEMORY and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @pointer_lifetime The returned buffer is valid until it is presented with
+ *  @ref glfwPresentX11SoftwareBuffer or the window is destroyed.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa glfwPresentX11SoftwareBuffer
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void* glfwGetX11SoftwareBuffer(GLFWwindow* window, int* width, int* height, int* stride);
+
+/*! @brief Presents the back buffer of the software surface of the window.
+ *
+ *  This function copies the specified areas of the buffer last returned by
+ *  @ref glfwGetX11SoftwareBuffer to the window and makes the other buffer the
+ *  back buffer.  Areas are given as consecutive x, y, width and height values
+ *  in pixels and are clipped to the buffer.
+ *
+ *  With MIT-SHM the copy is performed by the server after this function
+ *  returns, so the application must not write to the presented buffer until
+ *  it is returned by @ref glfwGetX11SoftwareBuffer again.
+ *
+ *  @param[in] window The window whose buffer to present.
+ *  @param[in] rects The areas to present, or `NULL` to present the whole
+ *  buffer.
+ *  @param[in] count The number of areas in the array, or zero to present the
+ *  whole buffer.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa glfwGetX11SoftwareBuffer
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwPresentX11SoftwareBuffer(GLFWwindow* window, const int* rects, int count);
+
 /*! @brief Sets the current primary selection to the specified string.
  *
  *  @param[in] string A UTF-8 encoded string.
@@ -372,6 +515,126 @@ GLFWAPI GLXContext glfwGetGLXContext(GLFWwindow* window);
  *  @ingroup native
  */
 GLFWAPI GLXWindow glfwGetGLXWindow(GLFWwindow* window);
+
+/*! @brief Retrieves the current sync values of the window.
+ *
+ *  This function retrieves the unadjusted system time (UST), media stream
+ *  counter (MSC) and swap buffer counter (SBC) of the specified window, as
+ *  defined by `GLX_OML_sync_control`.  The UST is in microseconds and the MSC
+ *  counts the vblanks of the monitor the window is on.
+ *
+ *  Any or all of the output parameters may be `NULL`.  If an error occurs,
+ *  all non-`NULL` output parameters will be set to zero.
+ *
+ *  @param[in] window The window to query.
+ *  @param[out] ust Where to store the UST, or `NULL`.
+ *  @param[out] msc Where to store the MSC, or `NULL`.
+ *  @param[out] sbc Where to store the SBC, or `NULL`.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT, @ref GLFW_API_UNAVAILABLE and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa glfwSwapGLXBuffersMsc
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwGetGLXSyncValues(GLFWwindow* window, int64_t* ust, int64_t* msc, int64_t* sbc);
+
+/*! @brief Retrieves the rate at which the MSC of the window increments.
+ *
+ *  This function retrieves the rate, in Hz, at which the media stream counter
+ *  of the specified window increments, as a fraction.
+ *
+ *  @param[in] window The window to query.
+ *  @param[out] numerator Where to store the numerator of the rate, or `NULL`.
+ *  @param[out] denominator Where to store the denominator of the rate, or
+ *  `NULL`.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT, @ref GLFW_API_UNAVAILABLE and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwGetGLXMscRate(GLFWwindow* window, int* numerator, int* denominator);
+
+/*! @brief Swaps the buffers of the window at a target MSC.
+ *
+ *  This function swaps the front and back buffers of the specified window
+ *  once its media stream counter reaches `target`, or, if `divisor` is
+ *  non-zero, at the first MSC after that for which `msc % divisor` equals
+ *  `remainder`.  A target of zero with a divisor of zero swaps at the next
+ *  vblank.  The swap interval is ignored.
+ *
+ *  Frames swapped with a target of their own count towards the missed
+ *  vblanks reported by @ref glfwGetX11FrameTiming.
+ *
+ *  @param[in] window The window whose buffers to swap.
+ *  @param[in] target The MSC to swap at.
+ *  @param[in] divisor The divisor of later MSCs to swap at, or zero.
+ *  @param[in] remainder The remainder of later MSCs to swap at.
+ *  @return The swap buffer counter the swap will complete with, or `-1` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT, @ref GLFW_API_UNAVAILABLE, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa glfwWaitGLXSwapComplete
+ *  @sa glfwSwapBuffers
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int64_t glfwSwapGLXBuffersMsc(GLFWwindow* window, int64_t target, int64_t divisor, int64_t remainder);
+
+/*! @brief Waits for a buffer swap of the window to complete.
+ *
+ *  This function waits until the swap buffer counter of the specified window
+ *  reaches `sbc` and retrieves the UST and MSC at which that swap completed.
+ *  An `sbc` of zero waits for all swaps already made.
+ *
+ *  Any or all of the output parameters may be `NULL`.  If an error occurs,
+ *  all non-`NULL` output parameters will be set to zero.
+ *
+ *  @param[in] window The window to wait for.
+ *  @param[in] sbc The swap buffer counter to wait for.
+ *  @param[out] ust Where to store the UST of the swap, or `NULL`.
+ *  @param[out] msc Where to store the MSC of the swap, or `NULL`.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT, @ref GLFW_API_UNAVAILABLE and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @remark This function does not process events while waiting.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa glfwSwapGLXBuffersMsc
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwWaitGLXSwapComplete(GLFWwindow* window, int64_t sbc, int64_t* ust, int64_t* msc);
 #endif
 
 #if defined(GLFW_EXPOSE_NATIVE_WAYLAND)
@@ -462,6 +725,288 @@ GLFWAPI int glfwGetMirMonitor(GLFWmonitor* monitor);
 GLFWAPI MirWindow* glfwGetMirWindow(GLFWwindow* window);
 #endif
 
+#if defined(GLFW_EXPOSE_NATIVE_DRM)
+/*! @brief Returns the DRM device file descriptor used by GLFW.
+ *
+ *  @return The file descriptor of the DRM device used for scanout, or `-1` if
+ *  an [error](@ref error_handling) occurred.
+ *
+ *  @thread_safety This function may be called from any thread.  Access is not
+ *  synchronized.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwGetDRMDevice(void);
+
+/*! @brief Returns the DRM CRTC ID of the specified monitor.
+ *
+ *  @return The DRM CRTC ID of the specified monitor, or zero if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @thread_safety This function may be called from any thread.  Access is not
+ *  synchronized.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI uint32_t glfwGetDRMAdapter(GLFWmonitor* monitor);
+
+/*! @brief Returns the DRM connector ID of the specified monitor.
+ *
+ *  @return The DRM connector ID of the specified monitor, or zero if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @thread_safety This function may be called from any thread.  Access is not
+ *  synchronized.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI uint32_t glfwGetDRMMonitor(GLFWmonitor* monitor);
+
+/*! @brief Sets the degamma ramp of the specified monitor.
+ *
+ *  This function sets the ramp the display engine uses to convert colors to
+ *  linear light before applying the [color transform](@ref
+ *  glfwSetDRMColorTransform) and the [gamma ramp](@ref glfwSetGammaRamp).
+ *  The ramp is resampled to the size of the hardware lookup table.  Passing
+ *  `NULL` passes colors through unchanged.
+ *
+ *  @param[in] monitor The monitor whose degamma ramp to set.
+ *  @param[in] ramp The degamma ramp to use, or `NULL`.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark The degamma ramp is reset when the library is terminated.
+ *
+ *  @pointer_lifetime The specified ramp is copied before this function
+ *  returns.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwSetDRMDegammaRamp(GLFWmonitor* monitor,
+                                  const GLFWgammaramp* ramp);
+
+/*! @brief Sets the color transform matrix of the specified monitor.
+ *
+ *  This function sets the 3x3 matrix, in row-major order, that the display
+ *  engine multiplies linear colors by before applying the [gamma
+ *  ramp](@ref glfwSetGammaRamp).  Passing `NULL` passes colors through
+ *  unchanged.
+ *
+ *  @param[in] monitor The monitor whose color transform to set.
+ *  @param[in] matrix The nine coefficients of the matrix, or `NULL`.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @remark The color transform is reset when the library is terminated.
+ *
+ *  @pointer_lifetime The specified matrix is copied before this function
+ *  returns.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwSetDRMColorTransform(GLFWmonitor* monitor, const float* matrix);
+
+/*! @brief Imports a dma-buf as a buffer that can be scanned out directly.
+ *
+ *  This function creates a DRM framebuffer from one to four dma-buf planes,
+ *  for example a decoded video frame, so that it can be presented with @ref
+ *  glfwPresentDRMBuffer or @ref glfwSetDRMOverlayBuffer without being copied.
+ *
+ *  @param[in] width The width, in pixels, of the buffer.
+ *  @param[in] height The height, in pixels, of the buffer.
+ *  @param[in] format The DRM fourcc format of the buffer.
+ *  @param[in] modifier The DRM format modifier of the buffer, or
+ *  `DRM_FORMAT_MOD_INVALID` to use the implicit layout.
+ *  @param[in] count The number of planes of the buffer.
+ *  @param[in] fds The dma-buf file descriptor of each plane.  Planes may share
+ *  a file descriptor.  GLFW does not take ownership of these.
+ *  @param[in] pitches The pitch, in bytes, of each plane.
+ *  @param[in] offsets The offset, in bytes, of each plane.
+ *  @return The ID of the imported buffer, or zero if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref glfwDestroyDRMBuffer
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI uint32_t glfwImportDRMBuffer(int width, int height,
+                                     uint32_t format, uint64_t modifier,
+                                     int count, const int* fds,
+                                     const uint32_t* pitches,
+                                     const uint32_t* offsets);
+
+/*! @brief Destroys a buffer imported with glfwImportDRMBuffer.
+ *
+ *  @param[in] buffer The buffer to destroy.  It must not be on screen.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwDestroyDRMBuffer(uint32_t buffer);
+
+/*! @brief Flips an imported buffer onto the primary plane of the window.
+ *
+ *  This function flips the specified buffer in place of the contents of the
+ *  window.  The buffer must be the size of the current video mode.  The next
+ *  buffer swap puts the rendered contents of the window back on screen.
+ *
+ *  This function blocks until every frame already swapped with @ref
+ *  glfwSwapBuffers has reached the screen, as only one flip can be in flight
+ *  per monitor.  It then queues the flip and returns without waiting for it to
+ *  complete.
+ *
+ *  @param[in] window The window to present the buffer in.
+ *  @param[in] buffer The buffer to present.  It must remain valid until it
+ *  has been replaced on screen.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwPresentDRMBuffer(GLFWwindow* window, uint32_t buffer);
+
+/*! @brief Shows an imported buffer on the overlay plane of the window.
+ *
+ *  This function places the specified buffer above the contents of the window,
+ *  scaled to the specified rectangle if the hardware supports it.  Passing
+ *  zero as the buffer hides the overlay.
+ *
+ *  This function blocks until the flip in flight for the window, if any, has
+ *  completed.
+ *
+ *  @param[in] window The window to show the buffer in.
+ *  @param[in] buffer The buffer to show, or zero to hide the overlay.
+ *  @param[in] xpos The x-coordinate, in pixels, of the overlay.
+ *  @param[in] ypos The y-coordinate, in pixels, of the overlay.
+ *  @param[in] width The width, in pixels, of the overlay.
+ *  @param[in] height The height, in pixels, of the overlay.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwSetDRMOverlayBuffer(GLFWwindow* window, uint32_t buffer,
+                                    int xpos, int ypos, int width, int height);
+
+/*! @brief Retrieves the timing of the most recent flip of the window.
+ *
+ *  This function retrieves the vblank sequence number and time at which the
+ *  most recent frame of the specified window reached the screen, as reported
+ *  by the kernel, along with the number of vblanks that frames have missed
+ *  since the window was created.  A frame misses a vblank if it reaches the
+ *  screen later than the first vblank after it was swapped.
+ *
+ *  Any or all of the output parameters may be `NULL`.  If an error occurs or
+ *  no frame has reached the screen yet, all non-`NULL` output parameters will
+ *  be set to zero.
+ *
+ *  @param[in] window The window to query.
+ *  @param[out] sequence Where to store the vblank sequence number of the
+ *  most recent flip, or `NULL`.
+ *  @param[out] time Where to store the time, in seconds, of the most recent
+ *  flip, in the time base of @ref glfwGetTime, or `NULL`.
+ *  @param[out] missed Where to store the number of missed vblanks, or `NULL`.
+ *  @return `GLFW_TRUE` if a frame has reached the screen, or `GLFW_FALSE`
+ *  otherwise.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark The values are updated as flip events are processed, which happens
+ *  during buffer swaps and event processing.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwGetDRMFrameTiming(GLFWwindow* window, uint64_t* sequence,
+                                  double* time, uint64_t* missed);
+
+/*! @brief Retrieves the most recently swapped frame of a headless window.
+ *
+ *  This function retrieves the dma-buf of the frame most recently swapped
+ *  with @ref glfwSwapBuffers for the specified [headless](@ref
+ *  GLFW_DRM_HEADLESS_hint) window, waiting for its rendering to complete.  The
+ *  buffer is linear, the size of the framebuffer of the window and can be
+ *  read without copying, either by mapping the file descriptor with `mmap`
+ *  or by importing it into another API.
+ *
+ *  Any or all of the output parameters may be `NULL`.  If an error occurs or
+ *  no frame has been swapped yet, all non-`NULL` output parameters will be
+ *  set to zero, except for the file descriptor, which will be set to `-1`.
+ *
+ *  @param[in] window The headless window to query.
+ *  @param[out] fd Where to store the dma-buf file descriptor of the frame, or
+ *  `NULL`.  This is a new file descriptor that the caller must close.
+ *  @param[out] format Where to store the DRM fourcc format of the frame, or
+ *  `NULL`.
+ *  @param[out] stride Where to store the stride, in bytes, of the frame, or
+ *  `NULL`.
+ *  @return `GLFW_TRUE` if a frame was available, or `GLFW_FALSE` otherwise.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @pointer_lifetime The contents of the frame remain valid until the next
+ *  call to @ref glfwSwapBuffers for the window, after which it may be rendered
+ *  to again.  The file descriptor itself remains valid until the caller
+ *  closes it, even after the window is destroyed.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwGetDRMFrameBuffer(GLFWwindow* window, int* fd,
+                                  uint32_t* format, uint32_t* stride);
+#endif
+
 #if defined(GLFW_EXPOSE_NATIVE_EGL)
 /*! @brief Returns the `EGLDisplay` used by GLFW.
  *
@@ -1599,6 +1599,18 @@ void _glfwPlatformPostEmptyEvent(void)
     [pool drain];
 }
 
+int _glfwPlatformWatchFileDescriptor(int fd, int events,
+                                     GLFWfdfun callback, void* pointer)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Cocoa: File descriptors cannot be watched");
+    return GLFW_FALSE;
+}
+
+void _glfwPlatformUnwatchFileDescriptor(int fd)
+{
+}
+
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
 {
     const NSRect contentRect = [window->ns.view frame];
@@ -1820,6 +1832,13 @@ const char* _glfwPlatformGetClipboardString(void)
     return _glfw.ns.clipboardString;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window,
+                                         GLFWclipboardfun cbfun,
+                                         double timeout)
+{
+    cbfun((GLFWwindow*) window, _glfwPlatformGetClipboardString());
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface || !_glfw.vk.MVK_macos_surface)
@@ -27,6 +27,489 @@
 
 #include "internal.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+#include <linux/vt.h>
+
+#include <gbm.h>
+#include <libudev.h>
+#include <libinput.h>
+
+// Older libdrm headers lack this capability
+#ifndef DRM_CAP_ATOMIC_ASYNC_PAGE_FLIP
+ #define DRM_CAP_ATOMIC_ASYNC_PAGE_FLIP 0x15
+#endif
+
+// Returns the number of connected connectors of the device, or -1 if it
+// cannot drive displays
+//
+static int getConnectedCount(int fd)
+{
+    int i, count = 0;
+    drmModeRes* res = drmModeGetResources(fd);
+    if (!res)
+        return -1;
+
+    if (!res->count_crtcs || !res->count_connectors)
+    {
+        drmModeFreeResources(res);
+        return -1;
+    }
+
+    for (i = 0;  i < res->count_connectors;  i++)
+    {
+        drmModeConnector* conn = drmModeGetConnector(fd, res->connectors[i]);
+        if (!conn)
+            continue;
+
+        if (conn->connection == DRM_MODE_CONNECTED)
+            count++;
+
+        drmModeFreeConnector(conn);
+    }
+
+    drmModeFreeResources(res);
+    return count;
+}
+
+// Chooses the scanout device and, if it cannot render or the render device
+// init hint is set, a separate render node
+//
+// The scanout device is the KMS capable device with the most connected
+// displays, so display-less GPUs on hybrid systems are passed over
+//
+// Devices that cannot drive displays at all are only chosen when there is
+// nothing better, and without any primary node only a render node is chosen,
+// for headless windows
+//
+static GLFWbool chooseDevices(char* card, char* render, size_t size)
+{
+    int i, count, best = -1, bestConnected = -2;
+    drmDevice* devices[_GLFW_DRM_MAX_DEVICES];
+
+    render[0] = '\0';
+
+    if (_glfw.hints.init.drm.renderDevice != GLFW_DONT_CARE)
+    {
+        snprintf(render, size, DRM_RENDER_DEV_NAME, DRM_DIR_NAME,
+                 128 + _glfw.hints.init.drm.renderDevice);
+    }
+
+    if (_glfw.hints.init.drm.device != GLFW_DONT_CARE)
+    {
+        snprintf(card, size, DRM_DEV_NAME, DRM_DIR_NAME,
+                 _glfw.hints.init.drm.device);
+        return GLFW_TRUE;
+    }
+
+    count = drmGetDevices2(0, devices, _GLFW_DRM_MAX_DEVICES);
+    if (count <= 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR, "DRM: No devices found");
+        return GLFW_FALSE;
+    }
+
+    for (i = 0;  i < count;  i++)
+    {
+        int fd, connected;
+
+        if (!(devices[i]->available_nodes & (1 << DRM_NODE_PRIMARY)))
+            continue;
+
+        fd = open(devices[i]->nodes[DRM_NODE_PRIMARY], O_RDWR | O_CLOEXEC);
+        if (fd < 0)
+            continue;
+
+        connected = getConnectedCount(fd);
+        close(fd);
+
+        if (connected > bestConnected)
+        {
+            best = i;
+            bestConnected = connected;
+        }
+    }
+
+    if (best == -1)
+    {
+        // Systems without any display controller can still render to
+        // headless windows on a render node
+        if (!render[0])
+        {
+            for (i = 0;  i < count;  i++)
+            {
+                if (devices[i]->available_nodes & (1 << DRM_NODE_RENDER))
+                {
+                    snprintf(render, size, "%s", devices[i]->nodes[DRM_NODE_RENDER]);
+                    break;
+                }
+            }
+        }
+
+        drmFreeDevices(devices, count);
+
+        if (!render[0])
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "DRM: No device capable of modesetting or rendering found");
+            return GLFW_FALSE;
+        }
+
+        card[0] = '\0';
+        return GLFW_TRUE;
+    }
+
+    snprintf(card, size, "%s", devices[best]->nodes[DRM_NODE_PRIMARY]);
+
+    // Display controllers without a GPU, as found on many SoCs, need buffers
+    // allocated and rendered on another device
+    if (!render[0] && !(devices[best]->available_nodes & (1 << DRM_NODE_RENDER)))
+    {
+        for (i = 0;  i < count;  i++)
+        {
+            if (devices[i]->available_nodes & (1 << DRM_NODE_RENDER))
+            {
+                snprintf(render, size, "%s", devices[i]->nodes[DRM_NODE_RENDER]);
+                break;
+            }
+        }
+    }
+
+    drmFreeDevices(devices, count);
+    return GLFW_TRUE;
+}
+
+// Opens the scanout device and creates the GBM device that buffers are
+// allocated from, on a separate render node if one was chosen
+//
+// Without a scanout device only headless windows can be created
+//
+static GLFWbool openDevices(void)
+{
+    char card[64], render[64];
+    uint64_t width, height, value;
+
+    if (!chooseDevices(card, render, sizeof(card)))
+        return GLFW_FALSE;
+
+    if (card[0])
+    {
+        _glfw.drm.fd = open(card, O_RDWR | O_CLOEXEC);
+        if (_glfw.drm.fd < 0)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "DRM: Failed to open %s: %s", card, strerror(errno));
+            return GLFW_FALSE;
+        }
+
+        // Atomic modesetting is used when available, as it lets the kernel
+        // wait for rendering to finish instead of the CPU
+        if (drmSetClientCap(_glfw.drm.fd, DRM_CLIENT_CAP_ATOMIC, 1) == 0)
+            _glfw.drm.atomic = GLFW_TRUE;
+
+        // Universal planes expose the primary plane and the formats it can
+        // scan out even without atomic modesetting
+        drmSetClientCap(_glfw.drm.fd, DRM_CLIENT_CAP_UNIVERSAL_PLANES, 1);
+
+        if (drmGetCap(_glfw.drm.fd, DRM_CAP_ASYNC_PAGE_FLIP, &value) == 0)
+            _glfw.drm.async_flip = value != 0;
+        if (drmGetCap(_glfw.drm.fd, DRM_CAP_ATOMIC_ASYNC_PAGE_FLIP, &value) == 0)
+            _glfw.drm.atomic_async_flip = value != 0;
+    }
+    else
+        _glfw.drm.fd = -1;
+
+    if (render[0])
+    {
+        _glfw.drm.render_fd = open(render, O_RDWR | O_CLOEXEC);
+        if (_glfw.drm.render_fd < 0)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "DRM: Failed to open %s: %s",
+                            render, strerror(errno));
+            return GLFW_FALSE;
+        }
+    }
+
+    dlopen("libglapi.so.0", RTLD_LAZY | RTLD_GLOBAL);
+    _glfw.drm.display = gbm_create_device(_glfw.drm.render_fd > 0 ?
+                                          _glfw.drm.render_fd : _glfw.drm.fd);
+    if (!_glfw.drm.display)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to create GBM device");
+        return GLFW_FALSE;
+    }
+
+    if (_glfw.drm.fd < 0)
+        return GLFW_TRUE;
+
+    // Cursor buffers must belong to the scanout device, as the cursor plane
+    // reads them directly
+    if (_glfw.drm.render_fd > 0)
+        _glfw.drm.cursor_device = gbm_create_device(_glfw.drm.fd);
+    else
+        _glfw.drm.cursor_device = _glfw.drm.display;
+
+    if (drmGetCap(_glfw.drm.fd, DRM_CAP_CURSOR_WIDTH, &width) != 0)
+        width = 64;
+    if (drmGetCap(_glfw.drm.fd, DRM_CAP_CURSOR_HEIGHT, &height) != 0)
+        height = 64;
+
+    _glfw.drm.cursor_width = (int) width;
+    _glfw.drm.cursor_height = (int) height;
+
+    return GLFW_TRUE;
+}
+
+// Records a VT switch request for the next event processing and wakes up any
+// thread waiting for events
+//
+static void handleVTSignal(int signal)
+{
+    const int error = errno;
+    const uint64_t value = 1;
+    ssize_t result;
+
+    if (signal == SIGUSR1)
+        _glfw.drm.vt_release = 1;
+    else
+        _glfw.drm.vt_acquire = 1;
+
+    result = write(_glfw.drm.empty_event_fd, &value, sizeof(value));
+    (void) result;
+
+    errno = error;
+}
+
+// Takes over switching away from and back to the VT the application runs on,
+// so that the display can be handed over and taken back by event processing
+//
+// Applications not running on a VT, for example over SSH, keep the display
+// until they exit
+//
+static void initVT(void)
+{
+    struct vt_mode mode;
+    struct sigaction sa;
+
+    _glfw.drm.active = GLFW_TRUE;
+
+    if (_glfw.drm.fd < 0)
+        return;
+
+    _glfw.drm.tty_fd = open("/dev/tty", O_RDWR | O_CLOEXEC);
+    if (_glfw.drm.tty_fd < 0)
+    {
+        _glfw.drm.tty_fd = 0;
+        return;
+    }
+
+    if (ioctl(_glfw.drm.tty_fd, VT_GETMODE, &_glfw.drm.vt_mode) != 0)
+    {
+        close(_glfw.drm.tty_fd);
+        _glfw.drm.tty_fd = 0;
+        return;
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handleVTSignal;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGUSR1, &sa, &_glfw.drm.vt_release_action);
+    sigaction(SIGUSR2, &sa, &_glfw.drm.vt_acquire_action);
+
+    memset(&mode, 0, sizeof(mode));
+    mode.mode = VT_PROCESS;
+    mode.relsig = SIGUSR1;
+    mode.acqsig = SIGUSR2;
+
+    if (ioctl(_glfw.drm.tty_fd, VT_SETMODE, &mode) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to take over VT switching: %s",
+                        strerror(errno));
+
+        sigaction(SIGUSR1, &_glfw.drm.vt_release_action, NULL);
+        sigaction(SIGUSR2, &_glfw.drm.vt_acquire_action, NULL);
+        close(_glfw.drm.tty_fd);
+        _glfw.drm.tty_fd = 0;
+    }
+}
+
+// Returns VT switching to the kernel
+//
+static void terminateVT(void)
+{
+    if (_glfw.drm.tty_fd <= 0)
+        return;
+
+    ioctl(_glfw.drm.tty_fd, VT_SETMODE, &_glfw.drm.vt_mode);
+    sigaction(SIGUSR1, &_glfw.drm.vt_release_action, NULL);
+    sigaction(SIGUSR2, &_glfw.drm.vt_acquire_action, NULL);
+
+    close(_glfw.drm.tty_fd);
+    _glfw.drm.tty_fd = 0;
+}
+
+static int openRestricted(const char* path, int flags, void* userData)
+{
+    const int fd = open(path, flags | O_CLOEXEC);
+    return fd < 0 ? -errno : fd;
+}
+
+static void closeRestricted(int fd, void* userData)
+{
+    close(fd);
+}
+
+static const struct libinput_interface inputInterface =
+{
+    openRestricted,
+    closeRestricted
+};
+
+static void createKeyTables(void)
+{
+    int scancode;
+
+    memset(_glfw.drm.keycodes, -1, sizeof(_glfw.drm.keycodes));
+    memset(_glfw.drm.scancodes, -1, sizeof(_glfw.drm.scancodes));
+
+    _glfw.drm.keycodes[KEY_GRAVE]      = GLFW_KEY_GRAVE_ACCENT;
+    _glfw.drm.keycodes[KEY_1]          = GLFW_KEY_1;
+    _glfw.drm.keycodes[KEY_2]          = GLFW_KEY_2;
+    _glfw.drm.keycodes[KEY_3]          = GLFW_KEY_3;
+    _glfw.drm.keycodes[KEY_4]          = GLFW_KEY_4;
+    _glfw.drm.keycodes[KEY_5]          = GLFW_KEY_5;
+    _glfw.drm.keycodes[KEY_6]          = GLFW_KEY_6;
+    _glfw.drm.keycodes[KEY_7]          = GLFW_KEY_7;
+    _glfw.drm.keycodes[KEY_8]          = GLFW_KEY_8;
+    _glfw.drm.keycodes[KEY_9]          = GLFW_KEY_9;
+    _glfw.drm.keycodes[KEY_0]          = GLFW_KEY_0;
+    _glfw.drm.keycodes[KEY_SPACE]      = GLFW_KEY_SPACE;
+    _glfw.drm.keycodes[KEY_MINUS]      = GLFW_KEY_MINUS;
+    _glfw.drm.keycodes[KEY_EQUAL]      = GLFW_KEY_EQUAL;
+    _glfw.drm.keycodes[KEY_Q]          = GLFW_KEY_Q;
+    _glfw.drm.keycodes[KEY_W]          = GLFW_KEY_W;
+    _glfw.drm.keycodes[KEY_E]          = GLFW_KEY_E;
+    _glfw.drm.keycodes[KEY_R]          = GLFW_KEY_R;
+    _glfw.drm.keycodes[KEY_T]          = GLFW_KEY_T;
+    _glfw.drm.keycodes[KEY_Y]          = GLFW_KEY_Y;
+    _glfw.drm.keycodes[KEY_U]          = GLFW_KEY_U;
+    _glfw.drm.keycodes[KEY_I]          = GLFW_KEY_I;
+    _glfw.drm.keycodes[KEY_O]          = GLFW_KEY_O;
+    _glfw.drm.keycodes[KEY_P]          = GLFW_KEY_P;
+    _glfw.drm.keycodes[KEY_LEFTBRACE]  = GLFW_KEY_LEFT_BRACKET;
+    _glfw.drm.keycodes[KEY_RIGHTBRACE] = GLFW_KEY_RIGHT_BRACKET;
+    _glfw.drm.keycodes[KEY_A]          = GLFW_KEY_A;
+    _glfw.drm.keycodes[KEY_S]          = GLFW_KEY_S;
+    _glfw.drm.keycodes[KEY_D]          = GLFW_KEY_D;
+    _glfw.drm.keycodes[KEY_F]          = GLFW_KEY_F;
+    _glfw.drm.keycodes[KEY_G]          = GLFW_KEY_G;
+    _glfw.drm.keycodes[KEY_H]          = GLFW_KEY_H;
+    _glfw.drm.keycodes[KEY_J]          = GLFW_KEY_J;
+    _glfw.drm.keycodes[KEY_K]          = GLFW_KEY_K;
+    _glfw.drm.keycodes[KEY_L]          = GLFW_KEY_L;
+    _glfw.drm.keycodes[KEY_SEMICOLON]  = GLFW_KEY_SEMICOLON;
+    _glfw.drm.keycodes[KEY_APOSTROPHE] = GLFW_KEY_APOSTROPHE;
+    _glfw.drm.keycodes[KEY_Z]          = GLFW_KEY_Z;
+    _glfw.drm.keycodes[KEY_X]          = GLFW_KEY_X;
+    _glfw.drm.keycodes[KEY_C]          = GLFW_KEY_C;
+    _glfw.drm.keycodes[KEY_V]          = GLFW_KEY_V;
+    _glfw.drm.keycodes[KEY_B]          = GLFW_KEY_B;
+    _glfw.drm.keycodes[KEY_N]          = GLFW_KEY_N;
+    _glfw.drm.keycodes[KEY_M]          = GLFW_KEY_M;
+    _glfw.drm.keycodes[KEY_COMMA]      = GLFW_KEY_COMMA;
+    _glfw.drm.keycodes[KEY_DOT]        = GLFW_KEY_PERIOD;
+    _glfw.drm.keycodes[KEY_SLASH]      = GLFW_KEY_SLASH;
+    _glfw.drm.keycodes[KEY_BACKSLASH]  = GLFW_KEY_BACKSLASH;
+    _glfw.drm.keycodes[KEY_ESC]        = GLFW_KEY_ESCAPE;
+    _glfw.drm.keycodes[KEY_TAB]        = GLFW_KEY_TAB;
+    _glfw.drm.keycodes[KEY_LEFTSHIFT]  = GLFW_KEY_LEFT_SHIFT;
+    _glfw.drm.keycodes[KEY_RIGHTSHIFT] = GLFW_KEY_RIGHT_SHIFT;
+    _glfw.drm.keycodes[KEY_LEFTCTRL]   = GLFW_KEY_LEFT_CONTROL;
+    _glfw.drm.keycodes[KEY_RIGHTCTRL]  = GLFW_KEY_RIGHT_CONTROL;
+    _glfw.drm.keycodes[KEY_LEFTALT]    = GLFW_KEY_LEFT_ALT;
+    _glfw.drm.keycodes[KEY_RIGHTALT]   = GLFW_KEY_RIGHT_ALT;
+    _glfw.drm.keycodes[KEY_LEFTMETA]   = GLFW_KEY_LEFT_SUPER;
+    _glfw.drm.keycodes[KEY_RIGHTMETA]  = GLFW_KEY_RIGHT_SUPER;
+    _glfw.drm.keycodes[KEY_MENU]       = GLFW_KEY_MENU;
+    _glfw.drm.keycodes[KEY_NUMLOCK]    = GLFW_KEY_NUM_LOCK;
+    _glfw.drm.keycodes[KEY_CAPSLOCK]   = GLFW_KEY_CAPS_LOCK;
+    _glfw.drm.keycodes[KEY_PRINT]      = GLFW_KEY_PRINT_SCREEN;
+    _glfw.drm.keycodes[KEY_SCROLLLOCK] = GLFW_KEY_SCROLL_LOCK;
+    _glfw.drm.keycodes[KEY_PAUSE]      = GLFW_KEY_PAUSE;
+    _glfw.drm.keycodes[KEY_DELETE]     = GLFW_KEY_DELETE;
+    _glfw.drm.keycodes[KEY_BACKSPACE]  = GLFW_KEY_BACKSPACE;
+    _glfw.drm.keycodes[KEY_ENTER]      = GLFW_KEY_ENTER;
+    _glfw.drm.keycodes[KEY_HOME]       = GLFW_KEY_HOME;
+    _glfw.drm.keycodes[KEY_END]        = GLFW_KEY_END;
+    _glfw.drm.keycodes[KEY_PAGEUP]     = GLFW_KEY_PAGE_UP;
+    _glfw.drm.keycodes[KEY_PAGEDOWN]   = GLFW_KEY_PAGE_DOWN;
+    _glfw.drm.keycodes[KEY_INSERT]     = GLFW_KEY_INSERT;
+    _glfw.drm.keycodes[KEY_LEFT]       = GLFW_KEY_LEFT;
+    _glfw.drm.keycodes[KEY_RIGHT]      = GLFW_KEY_RIGHT;
+    _glfw.drm.keycodes[KEY_DOWN]       = GLFW_KEY_DOWN;
+    _glfw.drm.keycodes[KEY_UP]         = GLFW_KEY_UP;
+    _glfw.drm.keycodes[KEY_F1]         = GLFW_KEY_F1;
+    _glfw.drm.keycodes[KEY_F2]         = GLFW_KEY_F2;
+    _glfw.drm.keycodes[KEY_F3]         = GLFW_KEY_F3;
+    _glfw.drm.keycodes[KEY_F4]         = GLFW_KEY_F4;
+    _glfw.drm.keycodes[KEY_F5]         = GLFW_KEY_F5;
+    _glfw.drm.keycodes[KEY_F6]         = GLFW_KEY_F6;
+    _glfw.drm.keycodes[KEY_F7]         = GLFW_KEY_F7;
+    _glfw.drm.keycodes[KEY_F8]         = GLFW_KEY_F8;
+    _glfw.drm.keycodes[KEY_F9]         = GLFW_KEY_F9;
+    _glfw.drm.keycodes[KEY_F10]        = GLFW_KEY_F10;
+    _glfw.drm.keycodes[KEY_F11]        = GLFW_KEY_F11;
+    _glfw.drm.keycodes[KEY_F12]        = GLFW_KEY_F12;
+    _glfw.drm.keycodes[KEY_F13]        = GLFW_KEY_F13;
+    _glfw.drm.keycodes[KEY_F14]        = GLFW_KEY_F14;
+    _glfw.drm.keycodes[KEY_F15]        = GLFW_KEY_F15;
+    _glfw.drm.keycodes[KEY_F16]        = GLFW_KEY_F16;
+    _glfw.drm.keycodes[KEY_F17]        = GLFW_KEY_F17;
+    _glfw.drm.keycodes[KEY_F18]        = GLFW_KEY_F18;
+    _glfw.drm.keycodes[KEY_F19]        = GLFW_KEY_F19;
+    _glfw.drm.keycodes[KEY_F20]        = GLFW_KEY_F20;
+    _glfw.drm.keycodes[KEY_F21]        = GLFW_KEY_F21;
+    _glfw.drm.keycodes[KEY_F22]        = GLFW_KEY_F22;
+    _glfw.drm.keycodes[KEY_F23]        = GLFW_KEY_F23;
+    _glfw.drm.keycodes[KEY_F24]        = GLFW_KEY_F24;
+    _glfw.drm.keycodes[KEY_KPSLASH]    = GLFW_KEY_KP_DIVIDE;
+    _glfw.drm.keycodes[KEY_KPASTERISK] = GLFW_KEY_KP_MULTIPLY;
+    _glfw.drm.keycodes[KEY_KPMINUS]    = GLFW_KEY_KP_SUBTRACT;
+    _glfw.drm.keycodes[KEY_KPPLUS]     = GLFW_KEY_KP_ADD;
+    _glfw.drm.keycodes[KEY_KP0]        = GLFW_KEY_KP_0;
+    _glfw.drm.keycodes[KEY_KP1]        = GLFW_KEY_KP_1;
+    _glfw.drm.keycodes[KEY_KP2]        = GLFW_KEY_KP_2;
+    _glfw.drm.keycodes[KEY_KP3]        = GLFW_KEY_KP_3;
+    _glfw.drm.keycodes[KEY_KP4]        = GLFW_KEY_KP_4;
+    _glfw.drm.keycodes[KEY_KP5]        = GLFW_KEY_KP_5;
+    _glfw.drm.keycodes[KEY_KP6]        = GLFW_KEY_KP_6;
+    _glfw.drm.keycodes[KEY_KP7]        = GLFW_KEY_KP_7;
+    _glfw.drm.keycodes[KEY_KP8]        = GLFW_KEY_KP_8;
+    _glfw.drm.keycodes[KEY_KP9]        = GLFW_KEY_KP_9;
+    _glfw.drm.keycodes[KEY_KPDOT]      = GLFW_KEY_KP_DECIMAL;
+    _glfw.drm.keycodes[KEY_KPEQUAL]    = GLFW_KEY_KP_EQUAL;
+    _glfw.drm.keycodes[KEY_KPENTER]    = GLFW_KEY_KP_ENTER;
+
+    for (scancode = 0;  scancode < 256;  scancode++)
+    {
+        if (_glfw.drm.keycodes[scancode] > 0)
+            _glfw.drm.scancodes[_glfw.drm.keycodes[scancode]] = scancode;
+    }
+}
+
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -34,12 +517,140 @@
 
 int _glfwPlatformInit(void)
 {
+    createKeyTables();
+
+    if (!openDevices())
+        return GLFW_FALSE;
+
+    _glfw.drm.udev = udev_new();
+    if (!_glfw.drm.udev)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to create udev context");
+        return GLFW_FALSE;
+    }
+
+    // Input devices are enumerated and opened by libinput, whose fd is
+    // dispatched from the event processing functions
+    _glfw.drm.libinput = libinput_udev_create_context(&inputInterface, NULL,
+                                                      _glfw.drm.udev);
+    if (!_glfw.drm.libinput)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to create libinput context");
+        return GLFW_FALSE;
+    }
+
+    if (libinput_udev_assign_seat(_glfw.drm.libinput, "seat0") != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to assign libinput seat");
+        return GLFW_FALSE;
+    }
+
+    _glfw.drm.touch_slot = -1;
+
+    // The layout is chosen by the XKB_DEFAULT_* environment variables, as
+    // there is no display server to query it from
+    _glfw.drm.xkb.context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+    if (!_glfw.drm.xkb.context)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to create XKB context");
+        return GLFW_FALSE;
+    }
+
+    _glfw.drm.xkb.keymap = xkb_keymap_new_from_names(_glfw.drm.xkb.context,
+                                                     NULL,
+                                                     XKB_KEYMAP_COMPILE_NO_FLAGS);
+    if (!_glfw.drm.xkb.keymap)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to compile XKB keymap");
+        return GLFW_FALSE;
+    }
+
+    _glfw.drm.xkb.state = xkb_state_new(_glfw.drm.xkb.keymap);
+    if (!_glfw.drm.xkb.state)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to create XKB state");
+        return GLFW_FALSE;
+    }
+
+    _glfw.drm.repeat_scancode = -1;
+    _glfw.drm.repeat_fd = timerfd_create(CLOCK_MONOTONIC,
+                                         TFD_CLOEXEC | TFD_NONBLOCK);
+    if (_glfw.drm.repeat_fd == -1)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to create key repeat timer: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    // Written to by glfwPostEmptyEvent to wake up any thread waiting for events
+    _glfw.drm.empty_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_glfw.drm.empty_event_fd == -1)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to create empty event fd: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    initVT();
+
     _glfwInitTimerPOSIX();
+
+    if (_glfw.drm.fd > 0)
+        _glfwPollMonitorsDRM();
+
     return GLFW_TRUE;
 }
 
 void _glfwPlatformTerminate(void)
 {
+    terminateVT();
+
+    if (_glfw.drm.libinput)
+    {
+        libinput_unref(_glfw.drm.libinput);
+        _glfw.drm.libinput = NULL;
+    }
+
+    if (_glfw.drm.udev)
+    {
+        udev_unref(_glfw.drm.udev);
+        _glfw.drm.udev = NULL;
+    }
+
+    if (_glfw.drm.xkb.state)
+        xkb_state_unref(_glfw.drm.xkb.state);
+    if (_glfw.drm.xkb.keymap)
+        xkb_keymap_unref(_glfw.drm.xkb.keymap);
+    if (_glfw.drm.xkb.context)
+        xkb_context_unref(_glfw.drm.xkb.context);
+    if (_glfw.drm.repeat_fd > 0)
+        close(_glfw.drm.repeat_fd);
+
+    if (_glfw.drm.empty_event_fd > 0)
+        close(_glfw.drm.empty_event_fd);
+
+    _glfwTerminateEGL();
+
+    if (_glfw.drm.default_cursor.bo)
+        gbm_bo_destroy(_glfw.drm.default_cursor.bo);
+    if (_glfw.drm.cursor_device && _glfw.drm.cursor_device != _glfw.drm.display)
+        gbm_device_destroy(_glfw.drm.cursor_device);
+
+    if (_glfw.drm.display)
+        gbm_device_destroy(_glfw.drm.display);
+    if (_glfw.drm.render_fd > 0)
+        close(_glfw.drm.render_fd);
+    if (_glfw.drm.fd > 0)
+        close(_glfw.drm.fd);
+
     // _glfwTerminateOSMesa();
 }
 
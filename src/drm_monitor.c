@@ -27,6 +27,706 @@
 
 #include "internal.h"
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <gbm.h>
+
+
+// Check whether the display mode should be included in enumeration
+//
+static GLFWbool modeIsGood(const drmModeModeInfo* mi)
+{
+    return (mi->flags & DRM_MODE_FLAG_INTERLACE) == 0;
+}
+
+// Calculates the refresh rate, in Hz, from the specified DRM mode info
+//
+static int calculateRefreshRate(const drmModeModeInfo* mi)
+{
+    if (mi->htotal && mi->vtotal)
+        return (int) (mi->clock * 1000.0 / ((double) mi->htotal * (double) mi->vtotal) + 0.5);
+    else
+        return mi->vrefresh;
+}
+
+// Convert DRM mode info to GLFW video mode
+//
+static GLFWvidmode vidmodeFromModeInfo(const drmModeModeInfo* mi)
+{
+    GLFWvidmode mode;
+
+    mode.width  = mi->hdisplay;
+    mode.height = mi->vdisplay;
+    mode.refreshRate = calculateRefreshRate(mi);
+
+    // Modes report the default XRGB8888 scanout format, as XRGB2101010 buffers
+    // are only allocated for windows requesting more than eight bits
+    mode.redBits = mode.greenBits = mode.blueBits = 8;
+
+    return mode;
+}
+
+// Returns the name the kernel uses for the specified connector type
+//
+static const char* getConnectorTypeName(uint32_t type)
+{
+    switch (type)
+    {
+        case DRM_MODE_CONNECTOR_VGA:         return "VGA";
+        case DRM_MODE_CONNECTOR_DVII:        return "DVI-I";
+        case DRM_MODE_CONNECTOR_DVID:        return "DVI-D";
+        case DRM_MODE_CONNECTOR_DVIA:        return "DVI-A";
+        case DRM_MODE_CONNECTOR_Composite:   return "Composite";
+        case DRM_MODE_CONNECTOR_SVIDEO:      return "SVIDEO";
+        case DRM_MODE_CONNECTOR_LVDS:        return "LVDS";
+        case DRM_MODE_CONNECTOR_Component:   return "Component";
+        case DRM_MODE_CONNECTOR_9PinDIN:     return "DIN";
+        case DRM_MODE_CONNECTOR_DisplayPort: return "DP";
+        case DRM_MODE_CONNECTOR_HDMIA:       return "HDMI-A";
+        case DRM_MODE_CONNECTOR_HDMIB:       return "HDMI-B";
+        case DRM_MODE_CONNECTOR_TV:          return "TV";
+        case DRM_MODE_CONNECTOR_eDP:         return "eDP";
+        case DRM_MODE_CONNECTOR_VIRTUAL:     return "Virtual";
+        case DRM_MODE_CONNECTOR_DSI:         return "DSI";
+        case DRM_MODE_CONNECTOR_DPI:         return "DPI";
+        default:                             return "Unknown";
+    }
+}
+
+// Returns whether the specified CRTC already drives a connected monitor
+//
+static GLFWbool crtcInUse(uint32_t crtc)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.monitorCount;  i++)
+    {
+        if (_glfw.monitors[i]->drm.crtc == crtc)
+            return GLFW_TRUE;
+    }
+
+    return GLFW_FALSE;
+}
+
+// Finds a CRTC not used by any other monitor that can drive the connector,
+// preferring the one it is currently bound to
+//
+static GLFWbool findCrtc(const drmModeRes* res, const drmModeConnector* conn,
+                         uint32_t* crtc, int* crtcIndex)
+{
+    int i, j;
+
+    if (conn->encoder_id)
+    {
+        drmModeEncoder* enc = drmModeGetEncoder(_glfw.drm.fd, conn->encoder_id);
+        if (enc)
+        {
+            for (j = 0;  j < res->count_crtcs;  j++)
+            {
+                if (enc->crtc_id == res->crtcs[j] && !crtcInUse(res->crtcs[j]))
+                {
+                    *crtc = res->crtcs[j];
+                    *crtcIndex = j;
+                    drmModeFreeEncoder(enc);
+                    return GLFW_TRUE;
+                }
+            }
+
+            drmModeFreeEncoder(enc);
+        }
+    }
+
+    for (i = 0;  i < conn->count_encoders;  i++)
+    {
+        drmModeEncoder* enc = drmModeGetEncoder(_glfw.drm.fd, conn->encoders[i]);
+        if (!enc)
+            continue;
+
+        for (j = 0;  j < res->count_crtcs;  j++)
+        {
+            if ((enc->possible_crtcs & (1 << j)) && !crtcInUse(res->crtcs[j]))
+            {
+                *crtc = res->crtcs[j];
+                *crtcIndex = j;
+                drmModeFreeEncoder(enc);
+                return GLFW_TRUE;
+            }
+        }
+
+        drmModeFreeEncoder(enc);
+    }
+
+    return GLFW_FALSE;
+}
+
+// Returns the ID of the named property of the specified KMS object, or zero
+// if the object has no such property
+//
+static uint32_t getPropertyID(uint32_t object, uint32_t type, const char* name)
+{
+    uint32_t i, id = 0;
+    drmModeObjectProperties* props;
+
+    props = drmModeObjectGetProperties(_glfw.drm.fd, object, type);
+    if (!props)
+        return 0;
+
+    for (i = 0;  i < props->count_props && !id;  i++)
+    {
+        drmModePropertyRes* prop = drmModeGetProperty(_glfw.drm.fd, props->props[i]);
+        if (!prop)
+            continue;
+
+        if (strcmp(prop->name, name) == 0)
+            id = prop->prop_id;
+
+        drmModeFreeProperty(prop);
+    }
+
+    drmModeFreeObjectProperties(props);
+    return id;
+}
+
+// Returns the current value of the named property of the specified KMS object
+//
+static GLFWbool getPropertyValue(uint32_t object, uint32_t type,
+                                 const char* name, uint64_t* value)
+{
+    uint32_t i;
+    GLFWbool found = GLFW_FALSE;
+    drmModeObjectProperties* props;
+
+    props = drmModeObjectGetProperties(_glfw.drm.fd, object, type);
+    if (!props)
+        return GLFW_FALSE;
+
+    for (i = 0;  i < props->count_props && !found;  i++)
+    {
+        drmModePropertyRes* prop = drmModeGetProperty(_glfw.drm.fd, props->props[i]);
+        if (!prop)
+            continue;
+
+        if (strcmp(prop->name, name) == 0)
+        {
+            *value = props->prop_values[i];
+            found = GLFW_TRUE;
+        }
+
+        drmModeFreeProperty(prop);
+    }
+
+    drmModeFreeObjectProperties(props);
+    return found;
+}
+
+// Returns whether the specified plane is the overlay plane of another monitor
+//
+static GLFWbool overlayInUse(uint32_t plane)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.monitorCount;  i++)
+    {
+        if (_glfw.monitors[i]->drm.overlay == plane)
+            return GLFW_TRUE;
+    }
+
+    return GLFW_FALSE;
+}
+
+// Finds an overlay plane for client buffers that the CRTC can use and no
+// other monitor has claimed, along with its properties if atomic commits are
+// available
+//
+static void initOverlay(_GLFWmonitor* monitor)
+{
+    uint32_t i;
+    drmModePlaneRes* planes;
+
+    monitor->drm.overlay = 0;
+
+    planes = drmModeGetPlaneResources(_glfw.drm.fd);
+    if (!planes)
+        return;
+
+    for (i = 0;  i < planes->count_planes && !monitor->drm.overlay;  i++)
+    {
+        uint64_t type;
+        drmModePlane* plane = drmModeGetPlane(_glfw.drm.fd, planes->planes[i]);
+        if (!plane)
+            continue;
+
+        if ((plane->possible_crtcs & (1 << monitor->drm.crtc_index)) &&
+            getPropertyValue(plane->plane_id, DRM_MODE_OBJECT_PLANE, "type", &type) &&
+            type == DRM_PLANE_TYPE_OVERLAY &&
+            !overlayInUse(plane->plane_id))
+        {
+            monitor->drm.overlay = plane->plane_id;
+        }
+
+        drmModeFreePlane(plane);
+    }
+
+    drmModeFreePlaneResources(planes);
+
+    if (!monitor->drm.overlay || !monitor->drm.atomic)
+        return;
+
+#define GET_PROPERTY(field, name) \
+    monitor->drm.overlay_props.field = \
+        getPropertyID(monitor->drm.overlay, DRM_MODE_OBJECT_PLANE, name); \
+    if (!monitor->drm.overlay_props.field) \
+    { \
+        monitor->drm.overlay = 0; \
+        return; \
+    }
+
+    GET_PROPERTY(fb_id, "FB_ID");
+    GET_PROPERTY(crtc_id, "CRTC_ID");
+    GET_PROPERTY(src_x, "SRC_X");
+    GET_PROPERTY(src_y, "SRC_Y");
+    GET_PROPERTY(src_w, "SRC_W");
+    GET_PROPERTY(src_h, "SRC_H");
+    GET_PROPERTY(crtc_x, "CRTC_X");
+    GET_PROPERTY(crtc_y, "CRTC_Y");
+    GET_PROPERTY(crtc_w, "CRTC_W");
+    GET_PROPERTY(crtc_h, "CRTC_H");
+
+#undef GET_PROPERTY
+}
+
+// Finds out whether the display and CRTC support variable refresh rate
+//
+static void initAdaptiveSync(_GLFWmonitor* monitor)
+{
+    uint64_t capable = 0;
+
+    monitor->drm.vrr_enabled_prop =
+        getPropertyID(monitor->drm.crtc, DRM_MODE_OBJECT_CRTC, "VRR_ENABLED");
+    getPropertyValue(monitor->drm.conn, DRM_MODE_OBJECT_CONNECTOR,
+                     "vrr_capable", &capable);
+
+    monitor->drm.vrr_capable = monitor->drm.vrr_enabled_prop && capable;
+}
+
+// Finds the color management properties of the CRTC and the sizes of its
+// lookup tables
+//
+static void initColorManagement(_GLFWmonitor* monitor)
+{
+    uint64_t size;
+    const uint32_t crtc = monitor->drm.crtc;
+
+    monitor->drm.gamma_lut_prop =
+        getPropertyID(crtc, DRM_MODE_OBJECT_CRTC, "GAMMA_LUT");
+    if (monitor->drm.gamma_lut_prop &&
+        getPropertyValue(crtc, DRM_MODE_OBJECT_CRTC, "GAMMA_LUT_SIZE", &size) &&
+        size > 0)
+    {
+        monitor->drm.gamma_lut_size = (uint32_t) size;
+    }
+    else
+        monitor->drm.gamma_lut_prop = 0;
+
+    monitor->drm.degamma_lut_prop =
+        getPropertyID(crtc, DRM_MODE_OBJECT_CRTC, "DEGAMMA_LUT");
+    if (monitor->drm.degamma_lut_prop &&
+        getPropertyValue(crtc, DRM_MODE_OBJECT_CRTC, "DEGAMMA_LUT_SIZE", &size) &&
+        size > 0)
+    {
+        monitor->drm.degamma_lut_size = (uint32_t) size;
+    }
+    else
+        monitor->drm.degamma_lut_prop = 0;
+
+    monitor->drm.ctm_prop = getPropertyID(crtc, DRM_MODE_OBJECT_CRTC, "CTM");
+}
+
+// Returns the value of the ramp at the specified position between two of its
+// entries
+//
+static uint16_t interpolateRamp(const unsigned short* values,
+                                unsigned int index, unsigned int next,
+                                double t)
+{
+    return (uint16_t) (values[index] * (1.0 - t) + values[next] * t + 0.5);
+}
+
+// Creates a lookup table blob of the specified size from the ramp, which is
+// resampled if its size differs
+//
+static GLFWbool createLutBlob(const GLFWgammaramp* ramp, uint32_t size,
+                              uint32_t* blob)
+{
+    uint32_t i;
+    int result;
+    struct drm_color_lut* lut = calloc(size, sizeof(struct drm_color_lut));
+    if (!lut)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    for (i = 0;  i < size;  i++)
+    {
+        double x = 0.0;
+        unsigned int index, next;
+
+        if (size > 1)
+            x = (double) i * (ramp->size - 1) / (size - 1);
+
+        index = (unsigned int) x;
+        next = index + 1 < ramp->size ? index + 1 : index;
+
+        lut[i].red = interpolateRamp(ramp->red, index, next, x - index);
+        lut[i].green = interpolateRamp(ramp->green, index, next, x - index);
+        lut[i].blue = interpolateRamp(ramp->blue, index, next, x - index);
+    }
+
+    result = drmModeCreatePropertyBlob(_glfw.drm.fd, lut,
+                                       size * sizeof(struct drm_color_lut),
+                                       blob);
+    free(lut);
+    return result == 0;
+}
+
+// Sets a blob property of the CRTC and destroys the blob it replaces
+//
+// Zero resets the property and the blob is destroyed if it cannot be set
+//
+static GLFWbool setCrtcBlob(_GLFWmonitor* monitor, uint32_t prop,
+                            uint32_t* current, uint32_t blob)
+{
+    if (drmModeObjectSetProperty(_glfw.drm.fd, monitor->drm.crtc,
+                                 DRM_MODE_OBJECT_CRTC, prop, blob) != 0)
+    {
+        if (blob)
+            drmModeDestroyPropertyBlob(_glfw.drm.fd, blob);
+
+        return GLFW_FALSE;
+    }
+
+    if (*current)
+        drmModeDestroyPropertyBlob(_glfw.drm.fd, *current);
+
+    *current = blob;
+    return GLFW_TRUE;
+}
+
+// Finds the primary plane of the CRTC and the properties needed for atomic
+// commits, falling back to legacy modesetting if any are missing
+//
+// The primary plane is also looked up for legacy modesetting, as its formats
+// and modifiers decide how scanout buffers are allocated
+//
+static void initAtomic(_GLFWmonitor* monitor)
+{
+    uint32_t i;
+    drmModePlaneRes* planes;
+
+    monitor->drm.atomic = GLFW_FALSE;
+    monitor->drm.plane = 0;
+
+    planes = drmModeGetPlaneResources(_glfw.drm.fd);
+    if (!planes)
+        return;
+
+    for (i = 0;  i < planes->count_planes && !monitor->drm.plane;  i++)
+    {
+        uint64_t type;
+        drmModePlane* plane = drmModeGetPlane(_glfw.drm.fd, planes->planes[i]);
+        if (!plane)
+            continue;
+
+        if ((plane->possible_crtcs & (1 << monitor->drm.crtc_index)) &&
+            getPropertyValue(plane->plane_id, DRM_MODE_OBJECT_PLANE, "type", &type) &&
+            type == DRM_PLANE_TYPE_PRIMARY)
+        {
+            monitor->drm.plane = plane->plane_id;
+        }
+
+        drmModeFreePlane(plane);
+    }
+
+    drmModeFreePlaneResources(planes);
+
+    if (!monitor->drm.plane || !_glfw.drm.atomic)
+        return;
+
+#define GET_PROPERTY(field, object, type, name) \
+    monitor->drm.props.field = getPropertyID(object, type, name); \
+    if (!monitor->drm.props.field) \
+        return;
+
+    GET_PROPERTY(conn_crtc_id, monitor->drm.conn, DRM_MODE_OBJECT_CONNECTOR, "CRTC_ID");
+    GET_PROPERTY(crtc_mode_id, monitor->drm.crtc, DRM_MODE_OBJECT_CRTC, "MODE_ID");
+    GET_PROPERTY(crtc_active, monitor->drm.crtc, DRM_MODE_OBJECT_CRTC, "ACTIVE");
+    GET_PROPERTY(plane_fb_id, monitor->drm.plane, DRM_MODE_OBJECT_PLANE, "FB_ID");
+    GET_PROPERTY(plane_crtc_id, monitor->drm.plane, DRM_MODE_OBJECT_PLANE, "CRTC_ID");
+    GET_PROPERTY(plane_src_x, monitor->drm.plane, DRM_MODE_OBJECT_PLANE, "SRC_X");
+    GET_PROPERTY(plane_src_y, monitor->drm.plane, DRM_MODE_OBJECT_PLANE, "SRC_Y");
+    GET_PROPERTY(plane_src_w, monitor->drm.plane, DRM_MODE_OBJECT_PLANE, "SRC_W");
+    GET_PROPERTY(plane_src_h, monitor->drm.plane, DRM_MODE_OBJECT_PLANE, "SRC_H");
+    GET_PROPERTY(plane_crtc_x, monitor->drm.plane, DRM_MODE_OBJECT_PLANE, "CRTC_X");
+    GET_PROPERTY(plane_crtc_y, monitor->drm.plane, DRM_MODE_OBJECT_PLANE, "CRTC_Y");
+    GET_PROPERTY(plane_crtc_w, monitor->drm.plane, DRM_MODE_OBJECT_PLANE, "CRTC_W");
+    GET_PROPERTY(plane_crtc_h, monitor->drm.plane, DRM_MODE_OBJECT_PLANE, "CRTC_H");
+
+#undef GET_PROPERTY
+
+    // The fence properties are optional and only used if present
+    monitor->drm.props.crtc_out_fence_ptr =
+        getPropertyID(monitor->drm.crtc, DRM_MODE_OBJECT_CRTC, "OUT_FENCE_PTR");
+    monitor->drm.props.plane_in_fence_fd =
+        getPropertyID(monitor->drm.plane, DRM_MODE_OBJECT_PLANE, "IN_FENCE_FD");
+
+    monitor->drm.atomic = GLFW_TRUE;
+}
+
+
+// Lays out the monitors left to right in their current modes
+//
+static void layoutMonitors(void)
+{
+    int i, xpos = 0;
+
+    for (i = 0;  i < _glfw.monitorCount;  i++)
+    {
+        _glfw.monitors[i]->drm.xpos = xpos;
+        xpos += _glfw.monitors[i]->drm.mode.hdisplay;
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Makes the mode closest to the desired one current for the monitor,
+// returning whether the mode changed
+//
+// The mode only takes effect once the window on the monitor has been given
+// buffers of the new size and modeset
+//
+GLFWbool _glfwSetVideoModeDRM(_GLFWmonitor* monitor, const GLFWvidmode* desired)
+{
+    int i;
+    GLFWvidmode current;
+    const GLFWvidmode* best;
+
+    best = _glfwChooseVideoMode(monitor, desired);
+    if (!best)
+        return GLFW_FALSE;
+
+    _glfwPlatformGetVideoMode(monitor, &current);
+    if (_glfwCompareVideoModes(&current, best) == 0)
+        return GLFW_FALSE;
+
+    for (i = 0;  i < monitor->drm.mode_count;  i++)
+    {
+        const drmModeModeInfo* mi = monitor->drm.modes + i;
+        GLFWvidmode mode;
+
+        if (!modeIsGood(mi))
+            continue;
+
+        mode = vidmodeFromModeInfo(mi);
+        if (_glfwCompareVideoModes(best, &mode) == 0)
+        {
+            monitor->drm.mode = *mi;
+            layoutMonitors();
+            return GLFW_TRUE;
+        }
+    }
+
+    return GLFW_FALSE;
+}
+
+// Makes the preferred mode current for the monitor again
+//
+void _glfwRestoreVideoModeDRM(_GLFWmonitor* monitor)
+{
+    monitor->drm.mode = monitor->drm.preferred_mode;
+    layoutMonitors();
+}
+
+// Retrieves the modifiers the primary plane of the monitor supports for the
+// specified format, returning whether the plane supports the format at all
+//
+// No modifiers are returned if the driver does not list them, in which case
+// the buffer layout is left to the driver
+//
+GLFWbool _glfwGetFormatModifiersDRM(_GLFWmonitor* monitor, uint32_t format,
+                                    uint64_t** modifiers, int* count)
+{
+    uint32_t i;
+    uint64_t blobID;
+    GLFWbool supported = GLFW_FALSE;
+    drmModePlane* plane;
+    drmModePropertyBlobRes* blob;
+
+    *modifiers = NULL;
+    *count = 0;
+
+    // Without universal planes only the common format can be assumed to work
+    if (!monitor->drm.plane)
+        return format == GBM_FORMAT_XRGB8888;
+
+    plane = drmModeGetPlane(_glfw.drm.fd, monitor->drm.plane);
+    if (!plane)
+        return format == GBM_FORMAT_XRGB8888;
+
+    for (i = 0;  i < plane->count_formats;  i++)
+    {
+        if (plane->formats[i] == format)
+            supported = GLFW_TRUE;
+    }
+
+    drmModeFreePlane(plane);
+
+    if (!supported)
+        return GLFW_FALSE;
+
+    if (!getPropertyValue(monitor->drm.plane, DRM_MODE_OBJECT_PLANE,
+                          "IN_FORMATS", &blobID))
+    {
+        return GLFW_TRUE;
+    }
+
+    blob = drmModeGetPropertyBlob(_glfw.drm.fd, (uint32_t) blobID);
+    if (!blob)
+        return GLFW_TRUE;
+
+    {
+        const struct drm_format_modifier_blob* header = blob->data;
+        const uint32_t* formats =
+            (const uint32_t*) ((const char*) header + header->formats_offset);
+        const struct drm_format_modifier* mods = (const struct drm_format_modifier*)
+            ((const char*) header + header->modifiers_offset);
+
+        for (i = 0;  i < header->count_formats;  i++)
+        {
+            if (formats[i] == format)
+                break;
+        }
+
+        if (i < header->count_formats)
+        {
+            // Each modifier lists the formats it applies to as a bitmask over
+            // a window of 64 entries starting at its offset
+            const uint32_t index = i;
+
+            *modifiers = calloc(header->count_modifiers, sizeof(uint64_t));
+            if (!*modifiers)
+            {
+                _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                drmModeFreePropertyBlob(blob);
+                return GLFW_TRUE;
+            }
+
+            for (i = 0;  i < header->count_modifiers;  i++)
+            {
+                if (index < mods[i].offset || index >= mods[i].offset + 64)
+                    continue;
+                if (!(mods[i].formats & (1ull << (index - mods[i].offset))))
+                    continue;
+                if (mods[i].modifier == DRM_FORMAT_MOD_INVALID)
+                    continue;
+
+                (*modifiers)[(*count)++] = mods[i].modifier;
+            }
+
+            if (!*count)
+            {
+                free(*modifiers);
+                *modifiers = NULL;
+            }
+        }
+    }
+
+    drmModeFreePropertyBlob(blob);
+    return GLFW_TRUE;
+}
+
+// Creates a monitor for every connected connector that a free CRTC can drive
+//
+// Monitors are laid out left to right in connector order, each starting out
+// with its preferred mode
+//
+void _glfwPollMonitorsDRM(void)
+{
+    int i, j, xpos = 0;
+    drmModeRes* res = drmModeGetResources(_glfw.drm.fd);
+    if (!res)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to retrieve resources: %s",
+                        strerror(errno));
+        return;
+    }
+
+    for (i = 0;  i < res->count_connectors;  i++)
+    {
+        char name[32];
+        uint32_t crtc;
+        int crtcIndex;
+        _GLFWmonitor* monitor;
+        drmModeConnector* conn = drmModeGetConnector(_glfw.drm.fd,
+                                                     res->connectors[i]);
+        if (!conn)
+            continue;
+
+        if (conn->connection != DRM_MODE_CONNECTED || !conn->count_modes ||
+            !findCrtc(res, conn, &crtc, &crtcIndex))
+        {
+            drmModeFreeConnector(conn);
+            continue;
+        }
+
+        snprintf(name, sizeof(name), "%s-%u",
+                 getConnectorTypeName(conn->connector_type),
+                 conn->connector_type_id);
+
+        monitor = _glfwAllocMonitor(name, conn->mmWidth, conn->mmHeight);
+        monitor->drm.conn = conn->connector_id;
+        monitor->drm.crtc = crtc;
+        monitor->drm.crtc_index = crtcIndex;
+        monitor->drm.xpos = xpos;
+
+        monitor->drm.mode_count = conn->count_modes;
+        monitor->drm.modes = calloc(conn->count_modes, sizeof(drmModeModeInfo));
+        memcpy(monitor->drm.modes, conn->modes,
+               conn->count_modes * sizeof(drmModeModeInfo));
+
+        monitor->drm.mode = conn->modes[0];
+        for (j = 0;  j < conn->count_modes;  j++)
+        {
+            if (conn->modes[j].type & DRM_MODE_TYPE_PREFERRED)
+            {
+                monitor->drm.mode = conn->modes[j];
+                break;
+            }
+        }
+
+        monitor->drm.preferred_mode = monitor->drm.mode;
+        xpos += monitor->drm.mode.hdisplay;
+
+        initAtomic(monitor);
+        initOverlay(monitor);
+        initAdaptiveSync(monitor);
+        initColorManagement(monitor);
+
+        _glfwInputMonitor(monitor, GLFW_CONNECTED, _GLFW_INSERT_LAST);
+        drmModeFreeConnector(conn);
+    }
+
+    drmModeFreeResources(res);
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -34,10 +734,36 @@
 
 void _glfwPlatformFreeMonitor(_GLFWmonitor* monitor)
 {
+    // The original gamma ramp has already been restored, but the color
+    // transform and degamma have no original to restore
+    if (monitor->drm.ctm_blob)
+        setCrtcBlob(monitor, monitor->drm.ctm_prop, &monitor->drm.ctm_blob, 0);
+    if (monitor->drm.degamma_blob)
+    {
+        setCrtcBlob(monitor, monitor->drm.degamma_lut_prop,
+                    &monitor->drm.degamma_blob, 0);
+    }
+
+    if (monitor->drm.ctm_blob)
+        drmModeDestroyPropertyBlob(_glfw.drm.fd, monitor->drm.ctm_blob);
+    if (monitor->drm.degamma_blob)
+        drmModeDestroyPropertyBlob(_glfw.drm.fd, monitor->drm.degamma_blob);
+    if (monitor->drm.gamma_blob)
+        drmModeDestroyPropertyBlob(_glfw.drm.fd, monitor->drm.gamma_blob);
+    if (monitor->drm.mode_blob)
+        drmModeDestroyPropertyBlob(_glfw.drm.fd, monitor->drm.mode_blob);
+    if (monitor->drm.saved_crtc)
+        drmModeFreeCrtc(monitor->drm.saved_crtc);
+
+    free(monitor->drm.modes);
 }
 
 void _glfwPlatformGetMonitorPos(_GLFWmonitor* monitor, int* xpos, int* ypos)
 {
+    if (xpos)
+        *xpos = monitor->drm.xpos;
+    if (ypos)
+        *ypos = monitor->drm.ypos;
 }
 
 void _glfwPlatformGetMonitorContentScale(_GLFWmonitor* monitor,
@@ -51,18 +777,255 @@ void _glfwPlatformGetMonitorContentScale(_GLFWmonitor* monitor,
 
 GLFWvidmode* _glfwPlatformGetVideoModes(_GLFWmonitor* monitor, int* found)
 {
-    return NULL;
+    int i, j;
+    GLFWvidmode* result = calloc(monitor->drm.mode_count, sizeof(GLFWvidmode));
+
+    *found = 0;
+
+    for (i = 0;  i < monitor->drm.mode_count;  i++)
+    {
+        GLFWvidmode mode;
+
+        if (!modeIsGood(monitor->drm.modes + i))
+            continue;
+
+        mode = vidmodeFromModeInfo(monitor->drm.modes + i);
+
+        for (j = 0;  j < *found;  j++)
+        {
+            if (_glfwCompareVideoModes(result + j, &mode) == 0)
+                break;
+        }
+
+        // Skip duplicate modes
+        if (j < *found)
+            continue;
+
+        (*found)++;
+        result[*found - 1] = mode;
+    }
+
+    return result;
 }
 
 void _glfwPlatformGetVideoMode(_GLFWmonitor* monitor, GLFWvidmode* mode)
 {
+    *mode = vidmodeFromModeInfo(&monitor->drm.mode);
 }
 
 void _glfwPlatformGetGammaRamp(_GLFWmonitor* monitor, GLFWgammaramp* ramp)
 {
+    int size;
+    drmModeCrtc* crtc;
+
+    if (monitor->drm.gamma_lut_prop)
+    {
+        uint32_t i;
+        uint64_t blobID = 0;
+        drmModePropertyBlobRes* blob = NULL;
+
+        _glfwAllocGammaArrays(ramp, monitor->drm.gamma_lut_size);
+
+        getPropertyValue(monitor->drm.crtc, DRM_MODE_OBJECT_CRTC,
+                         "GAMMA_LUT", &blobID);
+        if (blobID)
+            blob = drmModeGetPropertyBlob(_glfw.drm.fd, (uint32_t) blobID);
+
+        if (blob && blob->length == ramp->size * sizeof(struct drm_color_lut))
+        {
+            const struct drm_color_lut* lut = blob->data;
+
+            for (i = 0;  i < ramp->size;  i++)
+            {
+                ramp->red[i] = lut[i].red;
+                ramp->green[i] = lut[i].green;
+                ramp->blue[i] = lut[i].blue;
+            }
+        }
+        else
+        {
+            // Without a table the CRTC passes colors through unchanged
+            for (i = 0;  i < ramp->size;  i++)
+            {
+                const unsigned short value = ramp->size > 1 ?
+                    (unsigned short) ((i * 65535) / (ramp->size - 1)) : 0;
+                ramp->red[i] = ramp->green[i] = ramp->blue[i] = value;
+            }
+        }
+
+        if (blob)
+            drmModeFreePropertyBlob(blob);
+
+        return;
+    }
+
+    crtc = drmModeGetCrtc(_glfw.drm.fd, monitor->drm.crtc);
+    if (!crtc)
+        return;
+
+    size = crtc->gamma_size;
+    drmModeFreeCrtc(crtc);
+
+    if (size <= 0)
+        return;
+
+    _glfwAllocGammaArrays(ramp, size);
+
+    drmModeCrtcGetGamma(_glfw.drm.fd, monitor->drm.crtc, size,
+                        ramp->red, ramp->green, ramp->blue);
 }
 
 void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
 {
+    drmModeCrtc* crtc;
+
+    // The gamma lookup table property takes ramps of any size, which are
+    // resampled to the size of the hardware table
+    if (monitor->drm.gamma_lut_prop)
+    {
+        uint32_t blob;
+
+        if (createLutBlob(ramp, monitor->drm.gamma_lut_size, &blob) &&
+            setCrtcBlob(monitor, monitor->drm.gamma_lut_prop,
+                        &monitor->drm.gamma_blob, blob))
+        {
+            return;
+        }
+    }
+
+    crtc = drmModeGetCrtc(_glfw.drm.fd, monitor->drm.crtc);
+    if (!crtc)
+        return;
+
+    if (crtc->gamma_size != (int) ramp->size)
+    {
+        drmModeFreeCrtc(crtc);
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Gamma ramp size must match current ramp size");
+        return;
+    }
+
+    drmModeFreeCrtc(crtc);
+
+    if (drmModeCrtcSetGamma(_glfw.drm.fd, monitor->drm.crtc, ramp->size,
+                            ramp->red, ramp->green, ramp->blue) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to set gamma ramp: %s",
+                        strerror(errno));
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                        GLFW native API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWAPI uint32_t glfwGetDRMMonitor(GLFWmonitor* handle)
+{
+    _GLFWmonitor* monitor = (_GLFWmonitor*) handle;
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+    return monitor->drm.conn;
+}
+
+GLFWAPI uint32_t glfwGetDRMAdapter(GLFWmonitor* handle)
+{
+    _GLFWmonitor* monitor = (_GLFWmonitor*) handle;
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+    return monitor->drm.crtc;
+}
+
+GLFWAPI int glfwSetDRMDegammaRamp(GLFWmonitor* handle,
+                                  const GLFWgammaramp* ramp)
+{
+    uint32_t blob = 0;
+    _GLFWmonitor* monitor = (_GLFWmonitor*) handle;
+    assert(monitor != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (ramp && ramp->size == 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "DRM: Invalid degamma ramp size %i", ramp->size);
+        return GLFW_FALSE;
+    }
+
+    if (!monitor->drm.degamma_lut_prop)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: The CRTC has no degamma lookup table");
+        return GLFW_FALSE;
+    }
+
+    if (ramp &&
+        !createLutBlob(ramp, monitor->drm.degamma_lut_size, &blob))
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to create degamma lookup table: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    if (!setCrtcBlob(monitor, monitor->drm.degamma_lut_prop,
+                     &monitor->drm.degamma_blob, blob))
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to set degamma lookup table: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
 }
 
+GLFWAPI int glfwSetDRMColorTransform(GLFWmonitor* handle, const float* matrix)
+{
+    uint32_t blob = 0;
+    _GLFWmonitor* monitor = (_GLFWmonitor*) handle;
+    assert(monitor != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!monitor->drm.ctm_prop)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: The CRTC has no color transform matrix");
+        return GLFW_FALSE;
+    }
+
+    if (matrix)
+    {
+        int i;
+        struct drm_color_ctm ctm;
+
+        // The coefficients are in sign-magnitude S31.32 fixed point
+        for (i = 0;  i < 9;  i++)
+        {
+            const double value = matrix[i] < 0.f ? -matrix[i] : matrix[i];
+            ctm.matrix[i] = (uint64_t) (value * 4294967296.0 + 0.5);
+            if (matrix[i] < 0.f)
+                ctm.matrix[i] |= (uint64_t) 1 << 63;
+        }
+
+        if (drmModeCreatePropertyBlob(_glfw.drm.fd, &ctm, sizeof(ctm),
+                                      &blob) != 0)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "DRM: Failed to create color transform matrix: %s",
+                            strerror(errno));
+            return GLFW_FALSE;
+        }
+    }
+
+    if (!setCrtcBlob(monitor, monitor->drm.ctm_prop,
+                     &monitor->drm.ctm_blob, blob))
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to set color transform matrix: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
@@ -26,24 +26,28 @@
 //========================================================================
 
 #include <dlfcn.h>
+#include <signal.h>
+#include <linux/vt.h>
 #include <xf86drm.h>
 #include <xf86drmMode.h>
 #include <EGL/egl.h>
 #include <EGL/eglext.h>
+#include <xkbcommon/xkbcommon.h>
 
 #define _GLFW_EGL_NATIVE_WINDOW  ((EGLNativeWindowType) window->drm.window)
 #define _GLFW_EGL_NATIVE_DISPLAY ((EGLNativeDisplayType) _glfw.drm.display)
 
 #define _GLFW_PLATFORM_WINDOW_STATE _GLFWwindowDRM drm
 #define _GLFW_PLATFORM_CONTEXT_STATE
-#define _GLFW_PLATFORM_MONITOR_STATE
-#define _GLFW_PLATFORM_CURSOR_STATE
+#define _GLFW_PLATFORM_MONITOR_STATE _GLFWmonitorDRM drm
+#define _GLFW_PLATFORM_CURSOR_STATE _GLFWcursorDRM drm
 #define _GLFW_PLATFORM_LIBRARY_WINDOW_STATE _GLFWlibraryDRM drm
 #define _GLFW_PLATFORM_LIBRARY_CONTEXT_STATE
 
 #include "egl_context.h"
 #include "osmesa_context.h"
 #include "posix_time.h"
+#include "posix_poll.h"
 #include "posix_thread.h"
 #include "null_joystick.h"
 
@@ -57,37 +61,268 @@
  #define _glfw_dlsym(handle, name) dlsym(handle, name)
 #endif
 
+#define _GLFW_DRM_MAX_BUFFERS 4
+#define _GLFW_DRM_MAX_DEVICES 16
+
+// Key repeat delay and interval in milliseconds, as there is no display
+// server to configure them
+#define _GLFW_DRM_REPEAT_DELAY    600
+#define _GLFW_DRM_REPEAT_INTERVAL 40
+
+// Scanout buffer states
+#define _GLFW_DRM_BUFFER_FREE       0
+#define _GLFW_DRM_BUFFER_RENDERING  1
+#define _GLFW_DRM_BUFFER_QUEUED     2
+#define _GLFW_DRM_BUFFER_SCANOUT    3
+
 typedef struct Framebuffer {
+    int state;
+    // Signalled when rendering to or scanout from the buffer has finished
+    int render_fence;
+    int release_fence;
     struct gbm_bo* bo;
     int fd;
     uint32_t fb_id;
     EGLImageKHR image;
     GLuint gl_tex;
     GLuint gl_fb;
+    // GEM handle of the buffer imported into the scanout device, if allocated
+    // on a separate render node
+    uint32_t prime_handle;
 } Framebuffer;
 
-// Null-specific per-window data
+// DRM-specific per-cursor data
+//
+typedef struct _GLFWcursorDRM
+{
+  // Cursor plane buffer, always of the full hardware cursor size
+  struct gbm_bo* bo;
+  int xhot;
+  int yhot;
+} _GLFWcursorDRM;
+
+// DRM-specific per-window data
 //
 typedef struct _GLFWwindowDRM
 {
 	EGLNativeWindowType window;
+
+  // The monitor this window is scanned out on, or NULL if it is headless
+  _GLFWmonitor* output;
+
+  // Whether the window renders offscreen, and its size if so
+  GLFWbool headless;
+  int width;
+  int height;
+
+  // Format of the scanout buffers and the modifiers the primary plane
+  // supports for it, or none if the layout is left to the driver
+  uint32_t format;
+  uint64_t* modifiers;
+  int modifier_count;
+
+  Framebuffer framebuffers[_GLFW_DRM_MAX_BUFFERS];
+  int buffer_count;
+
+  // Buffer indices into the ring, or -1 if there is no such buffer
+  int scanout_buffer;
+  int flip_buffer;
+  int back_buffer;
+  int next_buffer;
+
+  // Swapped buffers waiting for the in-flight flip to complete, oldest first
+  int queue[_GLFW_DRM_MAX_BUFFERS];
+  int queue_count;
+
+  // Whether the flip in flight is of a client buffer instead of one from the
+  // ring, and whether it is onto the overlay plane instead of the primary
+  GLFWbool flip_client;
+  GLFWbool flip_overlay;
+
+  // Swap interval set with glfwSwapInterval and whether the flip of the
+  // oldest queued frame is waiting for the vblank before its target
+  int swap_interval;
+  GLFWbool flip_waiting;
+  GLFWbool adaptive_sync;
+
+  // Timing of the most recently completed flip, in vblanks and timer seconds
+  uint64_t flip_count;
+  uint64_t flip_sequence;
+  double flip_time;
+  // Vblanks that flips completed after the one they were queued for
+  uint64_t missed_frames;
+  uint32_t last_frame;
+  // The vblank the flip in flight should complete on, if known
+  uint32_t flip_target;
+  GLFWbool target_valid;
 } _GLFWwindowDRM;
 
+// DRM-specific per-monitor data
+//
+typedef struct _GLFWmonitorDRM
+{
+  uint32_t conn;
+  uint32_t crtc;
+  // Index of the CRTC in the device resources, as used by possible_crtcs
+  int crtc_index;
+  drmModeCrtc* saved_crtc;
+
+  // The current mode and the preferred mode the monitor returns to when no
+  // full screen window has chosen another
+  drmModeModeInfo mode;
+  drmModeModeInfo preferred_mode;
+  drmModeModeInfo* modes;
+  int mode_count;
+
+  // Position in the virtual screen spanning all monitors
+  int xpos;
+  int ypos;
+
+  // The window scanned out on this monitor, if any, and whether the monitor
+  // is still to be released after its window was destroyed while the VT was
+  // switched away
+  _GLFWwindow* window;
+  GLFWbool release_pending;
+
+  // The cursor shown on the cursor plane, or NULL if it is hidden
+  const _GLFWcursorDRM* cursor;
+
+  // Atomic modesetting state, used when the driver supports it
+  GLFWbool atomic;
+  uint32_t plane;
+  uint32_t mode_blob;
+  struct {
+      uint32_t conn_crtc_id;
+      uint32_t crtc_mode_id;
+      uint32_t crtc_active;
+      uint32_t crtc_out_fence_ptr;
+      uint32_t plane_fb_id;
+      uint32_t plane_crtc_id;
+      uint32_t plane_src_x;
+      uint32_t plane_src_y;
+      uint32_t plane_src_w;
+      uint32_t plane_src_h;
+      uint32_t plane_crtc_x;
+      uint32_t plane_crtc_y;
+      uint32_t plane_crtc_w;
+      uint32_t plane_crtc_h;
+      uint32_t plane_in_fence_fd;
+  } props;
+
+  // Variable refresh rate support and state of the CRTC
+  GLFWbool vrr_capable;
+  uint32_t vrr_enabled_prop;
+  GLFWbool vrr_enabled;
+
+  // Color management properties of the CRTC, or zero if it lacks them, along
+  // with the blobs GLFW has set them to
+  uint32_t gamma_lut_prop;
+  uint32_t gamma_lut_size;
+  uint32_t gamma_blob;
+  uint32_t degamma_lut_prop;
+  uint32_t degamma_lut_size;
+  uint32_t degamma_blob;
+  uint32_t ctm_prop;
+  uint32_t ctm_blob;
+
+  // Overlay plane for client buffers, or zero if there is none
+  uint32_t overlay;
+  struct {
+      uint32_t fb_id;
+      uint32_t crtc_id;
+      uint32_t src_x;
+      uint32_t src_y;
+      uint32_t src_w;
+      uint32_t src_h;
+      uint32_t crtc_x;
+      uint32_t crtc_y;
+      uint32_t crtc_w;
+      uint32_t crtc_h;
+  } overlay_props;
+} _GLFWmonitorDRM;
+
 // DRM-specific global data
 //
 typedef struct _GLFWlibraryDRM
 {
 	int fd;
-    drmModeModeInfo mode;
-    uint32_t conn;
-    uint32_t crtc;
-    drmModeCrtc* saved_crtc;
+  // Render node buffers are allocated from when the scanout device cannot
+  // render, or zero if buffers are allocated from the scanout device
+  int render_fd;
+
+  // Whether the device accepts atomic commits
+  GLFWbool atomic;
+  // Whether flips can complete immediately instead of at vblank, with legacy
+  // and atomic modesetting
+  GLFWbool async_flip;
+  GLFWbool atomic_async_flip;
 
-  Framebuffer framebuffers[2];
+  struct {
+      GLFWbool ANDROID_native_fence_sync;
+      GLFWbool KHR_wait_sync;
+      GLFWbool EXT_image_dma_buf_import_modifiers;
+      PFNEGLCREATESYNCKHRPROC CreateSyncKHR;
+      PFNEGLDESTROYSYNCKHRPROC DestroySyncKHR;
+      PFNEGLWAITSYNCKHRPROC WaitSyncKHR;
+      PFNEGLDUPNATIVEFENCEFDANDROIDPROC DupNativeFenceFDANDROID;
+      PFNEGLDESTROYIMAGEKHRPROC DestroyImageKHR;
+  } egl;
 
-  int front_buffer;
-  int page_flip_pending;
+  struct udev* udev;
+  struct libinput* libinput;
 
+  short int keycodes[256];
+  short int scancodes[GLFW_KEY_LAST + 1];
+  char keyName[64];
+  int modifiers;
+
+  // Keyboard layout translating keys to text and key names
+  struct {
+      struct xkb_context* context;
+      struct xkb_keymap* keymap;
+      struct xkb_state* state;
+  } xkb;
+
+  // Timer repeating the most recently pressed key while it is held, along
+  // with that key, or -1 as the scancode if no key is repeating
+  int repeat_fd;
+  int repeat_key;
+  int repeat_scancode;
+
+  // Pointer position in screen coordinates, shared by pointer and touch input
+  double cursor_x;
+  double cursor_y;
+  // The touch point emulating the pointer, or -1 if there is none
+  int32_t touch_slot;
+
+  // GBM device on the scanout device that cursor buffers are allocated from,
+  // along with the size of the cursor plane
+  struct gbm_device* cursor_device;
+  int cursor_width;
+  int cursor_height;
+  // Cursor shown for windows that have not set one
+  _GLFWcursorDRM default_cursor;
+
+  // Whether the application owns the display, which it gives up while its VT
+  // is switched away from
+  GLFWbool active;
+  int tty_fd;
+  struct vt_mode vt_mode;
+  struct sigaction vt_release_action;
+  struct sigaction vt_acquire_action;
+  // Set by the VT signal handlers and cleared by event processing
+  volatile sig_atomic_t vt_release;
+  volatile sig_atomic_t vt_acquire;
+
+  // Wakes up event waiting for glfwPostEmptyEvent
+  int empty_event_fd;
 
 	EGLNativeDisplayType display;
-} _GLFWlibraryDRM;
\ No newline at end of file
+} _GLFWlibraryDRM;
+
+
+void _glfwPollMonitorsDRM(void);
+GLFWbool _glfwSetVideoModeDRM(_GLFWmonitor* monitor, const GLFWvidmode* desired);
+void _glfwRestoreVideoModeDRM(_GLFWmonitor* monitor);
+GLFWbool _glfwGetFormatModifiersDRM(_GLFWmonitor* monitor, uint32_t format,
+                                    uint64_t** modifiers, int* count);
@@ -25,13 +25,21 @@
 //
 //========================================================================
 
+#define _GNU_SOURCE
+
 #include "internal.h"
 
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
 #include <stdio.h>
-#include <sys/select.h>
+#include <stdlib.h>
+#include <string.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <assert.h>
 
 #include <gbm.h>
 
@@ -39,180 +47,648 @@
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
 
+#include <linux/input.h>
 #include <libinput.h>
 
-static int createNativeWindow(_GLFWwindow* window,
-                              const _GLFWwndconfig* wndconfig)
+// Adds the properties placing the specified framebuffer full screen on the
+// primary plane of the monitor to an atomic request
+//
+static void addPlaneProperties(drmModeAtomicReq* req,
+                               _GLFWmonitor* monitor, uint32_t fb_id)
+{
+    const uint32_t plane = monitor->drm.plane;
+    const uint32_t width = monitor->drm.mode.hdisplay;
+    const uint32_t height = monitor->drm.mode.vdisplay;
+
+    drmModeAtomicAddProperty(req, plane, monitor->drm.props.plane_fb_id, fb_id);
+    drmModeAtomicAddProperty(req, plane, monitor->drm.props.plane_crtc_id, monitor->drm.crtc);
+    drmModeAtomicAddProperty(req, plane, monitor->drm.props.plane_src_x, 0);
+    drmModeAtomicAddProperty(req, plane, monitor->drm.props.plane_src_y, 0);
+    // Source coordinates are in 16.16 fixed point
+    drmModeAtomicAddProperty(req, plane, monitor->drm.props.plane_src_w, width << 16);
+    drmModeAtomicAddProperty(req, plane, monitor->drm.props.plane_src_h, height << 16);
+    drmModeAtomicAddProperty(req, plane, monitor->drm.props.plane_crtc_x, 0);
+    drmModeAtomicAddProperty(req, plane, monitor->drm.props.plane_crtc_y, 0);
+    drmModeAtomicAddProperty(req, plane, monitor->drm.props.plane_crtc_w, width);
+    drmModeAtomicAddProperty(req, plane, monitor->drm.props.plane_crtc_h, height);
+}
+
+// Performs the initial modeset of the monitor with an atomic commit
+//
+static GLFWbool modesetAtomic(_GLFWmonitor* monitor, uint32_t fb_id)
 {
-    // window->null.width = wndconfig->width;
-    // window->null.height = wndconfig->height;
+    int ret;
+    drmModeAtomicReq* req;
+
+    if (monitor->drm.mode_blob)
+    {
+        drmModeDestroyPropertyBlob(_glfw.drm.fd, monitor->drm.mode_blob);
+        monitor->drm.mode_blob = 0;
+    }
+
+    if (drmModeCreatePropertyBlob(_glfw.drm.fd, &monitor->drm.mode,
+                                  sizeof(monitor->drm.mode),
+                                  &monitor->drm.mode_blob) != 0)
+    {
+        return GLFW_FALSE;
+    }
+
+    req = drmModeAtomicAlloc();
+    drmModeAtomicAddProperty(req, monitor->drm.conn,
+                             monitor->drm.props.conn_crtc_id, monitor->drm.crtc);
+    drmModeAtomicAddProperty(req, monitor->drm.crtc,
+                             monitor->drm.props.crtc_mode_id, monitor->drm.mode_blob);
+    drmModeAtomicAddProperty(req, monitor->drm.crtc,
+                             monitor->drm.props.crtc_active, 1);
+    addPlaneProperties(req, monitor, fb_id);
+
+    ret = drmModeAtomicCommit(_glfw.drm.fd, req,
+                              DRM_MODE_ATOMIC_ALLOW_MODESET, NULL);
+    drmModeAtomicFree(req);
+
+    if (ret != 0)
+    {
+        drmModeDestroyPropertyBlob(_glfw.drm.fd, monitor->drm.mode_blob);
+        monitor->drm.mode_blob = 0;
+        return GLFW_FALSE;
+    }
 
     return GLFW_TRUE;
 }
 
-GLFWbool DeviceOpen(char *card) {
-  int fd = open(card, O_RDWR);// | O_CLOEXEC);
-  if (fd < 0) {
-    fprintf(stderr, "cannot open '%s': %m\n", card);
-    return GLFW_FALSE;
-  }
+// Queues a flip to the specified buffer with an atomic commit
+//
+// The render fence of the buffer is handed to the kernel, which latches the
+// buffer only once rendering has completed, and the returned out-fence is
+// signalled once the flip has taken effect and the previous buffer is off
+// screen
+//
+static GLFWbool pageFlipAtomic(_GLFWwindow* window, Framebuffer* fb,
+                               int* out_fence)
+{
+    int ret;
+    _GLFWmonitor* monitor = window->drm.output;
+    drmModeAtomicReq* req;
 
-  _glfw.drm.fd = fd;
+    if (window->drm.swap_interval == 0 && _glfw.drm.atomic_async_flip)
+    {
+        // Async commits may only change the framebuffer, so rendering is
+        // waited for through the implicit fence of the buffer
+        req = drmModeAtomicAlloc();
+        drmModeAtomicAddProperty(req, monitor->drm.plane,
+                                 monitor->drm.props.plane_fb_id, fb->fb_id);
+        ret = drmModeAtomicCommit(_glfw.drm.fd, req,
+                                  DRM_MODE_ATOMIC_NONBLOCK |
+                                  DRM_MODE_PAGE_FLIP_EVENT |
+                                  DRM_MODE_PAGE_FLIP_ASYNC,
+                                  window);
+        drmModeAtomicFree(req);
+
+        if (ret == 0)
+            return GLFW_TRUE;
+
+        // The driver rejects async flips for this configuration
+        _glfw.drm.atomic_async_flip = GLFW_FALSE;
+    }
 
-  return GLFW_TRUE;
+    req = drmModeAtomicAlloc();
+
+    addPlaneProperties(req, monitor, fb->fb_id);
+
+    if (fb->render_fence != -1 && monitor->drm.props.plane_in_fence_fd)
+    {
+        drmModeAtomicAddProperty(req, monitor->drm.plane,
+                                 monitor->drm.props.plane_in_fence_fd,
+                                 fb->render_fence);
+    }
+
+    if (monitor->drm.props.crtc_out_fence_ptr)
+    {
+        drmModeAtomicAddProperty(req, monitor->drm.crtc,
+                                 monitor->drm.props.crtc_out_fence_ptr,
+                                 (uint64_t) (uintptr_t) out_fence);
+    }
+
+    // The window is passed back to the page flip handler
+    ret = drmModeAtomicCommit(_glfw.drm.fd, req,
+                              DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT,
+                              window);
+    drmModeAtomicFree(req);
+
+    return ret == 0;
 }
 
-  GLFWbool FindCrtc(int fd,
-                drmModeRes* res,
-                drmModeConnector* conn,
-                uint32_t* crtc_out) {
-    /* first try the currently conected encoder+crtc */
-    if (conn->encoder_id) {
-      drmModeEncoder* enc = drmModeGetEncoder(fd, conn->encoder_id);
-      if (enc && enc->crtc_id) {
-        uint32_t crtc = enc->crtc_id;
-        // for (auto& dev : modeset_dev_list_) {
-        //   if (dev->crtc == crtc) {
-        //     break;
-        //   }
-        // }
-
-        if (crtc >= 0) {
-          drmModeFreeEncoder(enc);
-          *crtc_out = crtc;
-          return GLFW_TRUE;
-        }
-      }
-      drmModeFreeEncoder(enc);
-    }
-
-    /* If the connector is not currently bound to an encoder or if the
-     * encoder+crtc is already used by another connector (actually unlikely
-     * but lets be safe), iterate all other available encoders to find a
-     * matching CRTC. */
-    for (int i = 0; i < conn->count_encoders; ++i) {
-      drmModeEncoder* enc = drmModeGetEncoder(fd, conn->encoders[i]);
-      if (!enc) {
-        printf("cannot retrieve encoder %u:%u (%d): %m\n", i,
-                conn->encoders[i], errno);
-        continue;
-      }
-
-      /* iterate all global CRTCs */
-      for (int j = 0; j < res->count_crtcs; ++j) {
-        /* check whether this CRTC works with the encoder */
-        if (!(enc->possible_crtcs & (1 << j)))
-          continue;
-
-        /* check that no other device already uses this CRTC */
-        uint32_t crtc = res->crtcs[j];
-        // for (auto& dev : modeset_dev_list_) {
-        //   if (dev->crtc == crtc) {
-        //     break;
-        //   }
-        // }
-
-        /* we have found a CRTC, so save it and return */
-        if (crtc >= 0) {
-          drmModeFreeEncoder(enc);
-          *crtc_out = crtc;
-          return GLFW_TRUE;
-        }
-      }
-
-      drmModeFreeEncoder(enc);
-    }
-
-    fprintf(stderr, "cannot find suitable CRTC for connector %u\n",
-            conn->connector_id);
-    return GLFW_FALSE;
+// Returns the vblank request type for the CRTC of the window
+//
+static drmVBlankSeqType getVBlankType(_GLFWwindow* window, int type)
+{
+    const int index = window->drm.output->drm.crtc_index;
+
+    return (drmVBlankSeqType)
+        (type | ((index << DRM_VBLANK_HIGH_CRTC_SHIFT) & DRM_VBLANK_HIGH_CRTC_MASK));
+}
+
+// Records the vblank that a flip queued now should complete on, so that
+// frames completing later than that can be counted as missed
+//
+static void setFlipTarget(_GLFWwindow* window)
+{
+    drmVBlank vbl;
+
+    memset(&vbl, 0, sizeof(vbl));
+    vbl.request.type = getVBlankType(window, DRM_VBLANK_RELATIVE);
+    vbl.request.sequence = 0;
+
+    window->drm.target_valid = drmWaitVBlank(_glfw.drm.fd, &vbl) == 0;
+    if (window->drm.target_valid)
+        window->drm.flip_target = vbl.reply.sequence + 1;
+}
+
+GLFWbool PageFlip(_GLFWwindow* window, Framebuffer* fb, int* out_fence) {
+  int ret, error;
+  _GLFWmonitor* monitor = window->drm.output;
+
+  *out_fence = -1;
+
+  if (monitor->drm.atomic)
+    ret = pageFlipAtomic(window, fb, out_fence) ? 0 : -1;
+  else {
+    // A swap interval of zero flips without waiting for vblank, with tearing
+    if (window->drm.swap_interval == 0 && _glfw.drm.async_flip) {
+      ret = drmModePageFlip(_glfw.drm.fd, monitor->drm.crtc, fb->fb_id,
+                            DRM_MODE_PAGE_FLIP_EVENT | DRM_MODE_PAGE_FLIP_ASYNC, window);
+      if (ret)
+        _glfw.drm.async_flip = GLFW_FALSE;
+    }
+
+    if (window->drm.swap_interval != 0 || !_glfw.drm.async_flip)
+      ret = drmModePageFlip(_glfw.drm.fd, monitor->drm.crtc, fb->fb_id, DRM_MODE_PAGE_FLIP_EVENT, window);
+  }
+
+  error = errno;
+
+  // The kernel holds its own reference to the fence
+  if (fb->render_fence != -1) {
+    close(fb->render_fence);
+    fb->render_fence = -1;
   }
 
-GLFWbool GetConnector() {
-  /* retrieve resources */
-  drmModeRes* res = drmModeGetResources(_glfw.drm.fd);
-  if (!res) {
-    fprintf(stderr, "cannot retrieve DRM resources (%d): %m\n", errno);
+  if (ret) {
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "DRM: Failed to queue page flip: %s", strerror(error));
     return GLFW_FALSE;
   }
 
-  /* iterate all connectors */
-  for (int i = 0; i < res->count_connectors; ++i) {
-    /* get information for each connector */
-    drmModeConnector* conn = drmModeGetConnector(_glfw.drm.fd, res->connectors[i]);
-    if (!conn) {
-      fprintf(stderr, "cannot retrieve DRM connector %u:%u (%d): %m\n", i,
-              res->connectors[i], errno);
-      continue;
-    }
+  setFlipTarget(window);
+  return GLFW_TRUE;
+}
+
+// Queues a flip to a client buffer on the primary or overlay plane
+//
+// Overlay updates without atomic modesetting take effect immediately and
+// generate no flip event
+//
+static GLFWbool pageFlipClient(_GLFWwindow* window, uint32_t fb_id,
+                               GLFWbool overlay,
+                               int xpos, int ypos, int width, int height)
+{
+    int ret;
+    uint32_t fbWidth = 0, fbHeight = 0;
+    _GLFWmonitor* monitor = window->drm.output;
 
-    /* check if a monitor is connected */
-    if (conn->connection != DRM_MODE_CONNECTED) {
-      drmModeFreeConnector(conn);
-      fprintf(stderr, "ignoring unused connector %u\n", conn->connector_id);
-      continue;
+    if (!_glfw.drm.active)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: The display is in use by another VT");
+        return GLFW_FALSE;
     }
 
-    /* check if there is at least one valid mode */
-    if (!conn->count_modes) {
-      drmModeFreeConnector(conn);
-      fprintf(stderr, "no valid mode for connector %u\n", conn->connector_id);
-      continue;
+    if (fb_id)
+    {
+        drmModeFB* fb = drmModeGetFB(_glfw.drm.fd, fb_id);
+        if (!fb)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "DRM: Invalid client buffer %u", fb_id);
+            return GLFW_FALSE;
+        }
+
+        fbWidth = fb->width;
+        fbHeight = fb->height;
+        drmModeFreeFB(fb);
     }
 
-    _glfw.drm.conn = conn->connector_id;
-    _glfw.drm.mode = conn->modes[0];
+    if (!overlay)
+    {
+        if (!fb_id)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "DRM: The primary plane cannot be disabled");
+            return GLFW_FALSE;
+        }
+
+        if (fbWidth != monitor->drm.mode.hdisplay ||
+            fbHeight != monitor->drm.mode.vdisplay)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "DRM: Client buffer size must match the video mode");
+            return GLFW_FALSE;
+        }
 
-    /* find a crtc for this connector */
-    if (!FindCrtc(_glfw.drm.fd, res, conn, &_glfw.drm.crtc)) {
-      fprintf(stderr, "cannot setup device for connector %u:%u (%d): %m\n", i,
-              res->connectors[i], errno);
-      drmModeFreeConnector(conn);
-      continue;
+        if (monitor->drm.atomic)
+        {
+            drmModeAtomicReq* req = drmModeAtomicAlloc();
+            addPlaneProperties(req, monitor, fb_id);
+            ret = drmModeAtomicCommit(_glfw.drm.fd, req,
+                                      DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT,
+                                      window);
+            drmModeAtomicFree(req);
+        }
+        else
+        {
+            ret = drmModePageFlip(_glfw.drm.fd, monitor->drm.crtc, fb_id,
+                                  DRM_MODE_PAGE_FLIP_EVENT, window);
+        }
     }
+    else if (monitor->drm.atomic)
+    {
+        const uint32_t plane = monitor->drm.overlay;
+        drmModeAtomicReq* req = drmModeAtomicAlloc();
 
-    /* free connector data and link device into global list */
-    drmModeFreeConnector(conn);
-    //modeset_dev_ = dev.get();
-    //modeset_dev_list_.push_back(std::move(dev));
+        drmModeAtomicAddProperty(req, plane, monitor->drm.overlay_props.fb_id, fb_id);
+        drmModeAtomicAddProperty(req, plane, monitor->drm.overlay_props.crtc_id,
+                                 fb_id ? monitor->drm.crtc : 0);
 
-    // FIXME(dshwang): GetConnector() can support multiple connector, but
-    // it makes page flip logic is so complicated. So use only one connector.
-    // Most embedded devices have only one monitor.
-    break;
-  }
+        if (fb_id)
+        {
+            // Source coordinates are in 16.16 fixed point
+            drmModeAtomicAddProperty(req, plane, monitor->drm.overlay_props.src_x, 0);
+            drmModeAtomicAddProperty(req, plane, monitor->drm.overlay_props.src_y, 0);
+            drmModeAtomicAddProperty(req, plane, monitor->drm.overlay_props.src_w, fbWidth << 16);
+            drmModeAtomicAddProperty(req, plane, monitor->drm.overlay_props.src_h, fbHeight << 16);
+            drmModeAtomicAddProperty(req, plane, monitor->drm.overlay_props.crtc_x, xpos);
+            drmModeAtomicAddProperty(req, plane, monitor->drm.overlay_props.crtc_y, ypos);
+            drmModeAtomicAddProperty(req, plane, monitor->drm.overlay_props.crtc_w, width);
+            drmModeAtomicAddProperty(req, plane, monitor->drm.overlay_props.crtc_h, height);
+        }
 
-  /* free resources again */
-  drmModeFreeResources(res);
-  return GLFW_TRUE;
+        ret = drmModeAtomicCommit(_glfw.drm.fd, req,
+                                  DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT,
+                                  window);
+        drmModeAtomicFree(req);
+    }
+    else
+    {
+        ret = drmModeSetPlane(_glfw.drm.fd, monitor->drm.overlay,
+                              fb_id ? monitor->drm.crtc : 0, fb_id, 0,
+                              xpos, ypos, width, height,
+                              0, 0, fbWidth << 16, fbHeight << 16);
+        if (ret == 0)
+            return GLFW_TRUE;
+    }
+
+    if (ret != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to flip to client buffer: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    window->drm.flip_client = GLFW_TRUE;
+    window->drm.flip_overlay = overlay;
+    setFlipTarget(window);
+    return GLFW_TRUE;
 }
 
-GLFWbool PageFlip(uint32_t fb_id, void* user_data) {
-  int ret = drmModePageFlip(_glfw.drm.fd, _glfw.drm.crtc, fb_id, DRM_MODE_PAGE_FLIP_EVENT, user_data);
-  if (ret) {
-    fprintf(stderr, "failed to queue page flip: %m\n");
-    return GLFW_FALSE;
-  }
-  return GLFW_TRUE;
+// Loads the EGL fence entry points used to pass rendering completion to and
+// scanout completion from the kernel, and checks whether explicit buffer
+// layouts can be imported
+//
+static void loadFenceFunctions(void)
+{
+    const char* extensions = eglQueryString(_glfw.egl.display, EGL_EXTENSIONS);
+    if (!extensions)
+        return;
+
+    _glfw.drm.egl.EXT_image_dma_buf_import_modifiers =
+        _glfwStringInExtensionString("EGL_EXT_image_dma_buf_import_modifiers",
+                                     extensions);
+
+    _glfw.drm.egl.CreateSyncKHR = (PFNEGLCREATESYNCKHRPROC)
+        eglGetProcAddress("eglCreateSyncKHR");
+    _glfw.drm.egl.DestroySyncKHR = (PFNEGLDESTROYSYNCKHRPROC)
+        eglGetProcAddress("eglDestroySyncKHR");
+    _glfw.drm.egl.WaitSyncKHR = (PFNEGLWAITSYNCKHRPROC)
+        eglGetProcAddress("eglWaitSyncKHR");
+    _glfw.drm.egl.DupNativeFenceFDANDROID = (PFNEGLDUPNATIVEFENCEFDANDROIDPROC)
+        eglGetProcAddress("eglDupNativeFenceFDANDROID");
+    _glfw.drm.egl.DestroyImageKHR = (PFNEGLDESTROYIMAGEKHRPROC)
+        eglGetProcAddress("eglDestroyImageKHR");
+
+    if (_glfw.drm.egl.CreateSyncKHR &&
+        _glfw.drm.egl.DestroySyncKHR &&
+        _glfw.drm.egl.DupNativeFenceFDANDROID)
+    {
+        _glfw.drm.egl.ANDROID_native_fence_sync =
+            _glfwStringInExtensionString("EGL_ANDROID_native_fence_sync",
+                                         extensions);
+    }
+
+    if (_glfw.drm.egl.ANDROID_native_fence_sync && _glfw.drm.egl.WaitSyncKHR)
+    {
+        _glfw.drm.egl.KHR_wait_sync =
+            _glfwStringInExtensionString("EGL_KHR_wait_sync", extensions);
+    }
 }
 
-void EGLSyncFence() {
-  if (1) {//egl_.egl_sync_supported) {
-    EGLSyncKHR sync =
-        eglCreateSyncKHR(_glfw.egl.display, EGL_SYNC_FENCE_KHR, NULL);
+// Returns a native fence fd signalled when the rendering commands issued so
+// far have completed, or -1 if native fences are not available
+//
+static int createRenderFence(_GLFWwindow* window)
+{
+    int fd;
+    EGLSyncKHR sync;
+
+    // Headless windows hand the fence to the reader instead of the kernel
+    if ((window->drm.output && !window->drm.output->drm.atomic) ||
+        !_glfw.drm.egl.ANDROID_native_fence_sync)
+        return -1;
+
+    sync = _glfw.drm.egl.CreateSyncKHR(_glfw.egl.display,
+                                       EGL_SYNC_NATIVE_FENCE_ANDROID, NULL);
+    if (sync == EGL_NO_SYNC_KHR)
+        return -1;
+
+    // The fence fd is only available once the fence command has been flushed
     glFlush();
-    eglClientWaitSyncKHR(_glfw.egl.display, sync, 0, EGL_FOREVER_KHR);
-  } else {
-    glFinish();
-  }
+
+    fd = _glfw.drm.egl.DupNativeFenceFDANDROID(_glfw.egl.display, sync);
+    _glfw.drm.egl.DestroySyncKHR(_glfw.egl.display, sync);
+
+    if (fd == EGL_NO_NATIVE_FENCE_FD_ANDROID)
+        return -1;
+
+    return fd;
+}
+
+// Makes the GPU wait for the specified native fence before executing any
+// further rendering commands, taking ownership of the fd
+//
+static GLFWbool waitForFenceGPU(int fd)
+{
+    EGLSyncKHR sync;
+    const EGLint attribs[] = { EGL_SYNC_NATIVE_FENCE_FD_ANDROID, fd, EGL_NONE };
+
+    sync = _glfw.drm.egl.CreateSyncKHR(_glfw.egl.display,
+                                       EGL_SYNC_NATIVE_FENCE_ANDROID, attribs);
+    if (sync == EGL_NO_SYNC_KHR)
+    {
+        close(fd);
+        return GLFW_FALSE;
+    }
+
+    _glfw.drm.egl.WaitSyncKHR(_glfw.egl.display, sync, 0);
+    _glfw.drm.egl.DestroySyncKHR(_glfw.egl.display, sync);
+    return GLFW_TRUE;
+}
+
+// Makes the context of the window current if it is not already, returning the
+// window whose context was current
+//
+// Buffers are acquired and released while processing events for any window,
+// so their GL objects may belong to a context other than the current one
+//
+static _GLFWwindow* pushContext(_GLFWwindow* window)
+{
+    _GLFWwindow* previous = _glfwPlatformGetTls(&_glfw.contextSlot);
+    if (previous != window)
+        window->context.makeCurrent(window);
+
+    return previous;
+}
+
+// Restores the context made current before the matching pushContext
+//
+static void popContext(_GLFWwindow* window, _GLFWwindow* previous)
+{
+    if (previous != window)
+        window->context.makeCurrent(previous);
+}
+
+// Makes the next buffer in the ring the render target if it is free
+//
+// Buffers are handed out in ring order, which is also the order in which
+// they leave the screen, so the next buffer is always the first to become
+// free and the number of frames rendered ahead stays bounded by the ring size
+//
+static void acquireBackBuffer(_GLFWwindow* window)
+{
+    int fence = -1;
+    _GLFWwindow* previous;
+    Framebuffer* fb = &window->drm.framebuffers[window->drm.next_buffer];
+
+    if (fb->state == _GLFW_DRM_BUFFER_SCANOUT && fb->release_fence != -1 &&
+        _glfw.drm.egl.KHR_wait_sync)
+    {
+        // The buffer is being replaced on screen by the in-flight flip, so it
+        // can be rendered to as soon as the GPU has waited for that flip
+        fence = fb->release_fence;
+        fb->release_fence = -1;
+    }
+    else if (fb->state != _GLFW_DRM_BUFFER_FREE)
+        return;
+
+    previous = pushContext(window);
+
+    if (fence == -1 || waitForFenceGPU(fence))
+    {
+        fb->state = _GLFW_DRM_BUFFER_RENDERING;
+        window->drm.back_buffer = window->drm.next_buffer;
+        window->drm.next_buffer =
+            (window->drm.next_buffer + 1) % window->drm.buffer_count;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fb->gl_fb);
+    }
+
+    popContext(window, previous);
+}
+
+// Returns whether the window has a flip in flight
+//
+static GLFWbool flipPending(_GLFWwindow* window)
+{
+    return window->drm.flip_buffer != -1 || window->drm.flip_client ||
+           window->drm.flip_waiting;
+}
+
+// Queues a flip to the oldest swapped buffer of the window
+//
+static void submitPageFlip(_GLFWwindow* window)
+{
+    int release_fence;
+    const int index = window->drm.queue[0];
+    Framebuffer* fb = &window->drm.framebuffers[index];
+
+    window->drm.queue_count--;
+    memmove(window->drm.queue, window->drm.queue + 1,
+            window->drm.queue_count * sizeof(int));
+
+    if (!PageFlip(window, fb, &release_fence))
+    {
+        // The frame is dropped and its buffer returned to the ring
+        fb->state = _GLFW_DRM_BUFFER_FREE;
+        return;
+    }
+
+    if (window->drm.scanout_buffer != -1)
+        window->drm.framebuffers[window->drm.scanout_buffer].release_fence = release_fence;
+    else if (release_fence != -1)
+        close(release_fence);
+
+    window->drm.flip_buffer = index;
+}
+
+// Queues a flip to the oldest swapped buffer of the window once the swap
+// interval has elapsed since the previous flip
+//
+// With a swap interval above one, the flip is submitted at the vblank before
+// the one it should complete on, which is reported to the vblank handler
+//
+static void schedulePageFlip(_GLFWwindow* window)
+{
+    drmVBlank vbl;
+    uint32_t target;
+
+    if (window->drm.swap_interval < 2 || !window->drm.flip_count)
+    {
+        submitPageFlip(window);
+        return;
+    }
+
+    target = window->drm.last_frame + window->drm.swap_interval;
+
+    memset(&vbl, 0, sizeof(vbl));
+    vbl.request.type = getVBlankType(window, DRM_VBLANK_RELATIVE);
+    vbl.request.sequence = 0;
+
+    // A flip submitted now completes in time if the target is the next vblank
+    if (drmWaitVBlank(_glfw.drm.fd, &vbl) != 0 ||
+        (int32_t) (target - vbl.reply.sequence) <= 1)
+    {
+        submitPageFlip(window);
+        return;
+    }
+
+    memset(&vbl, 0, sizeof(vbl));
+    vbl.request.type = getVBlankType(window, DRM_VBLANK_ABSOLUTE | DRM_VBLANK_EVENT);
+    vbl.request.sequence = target - 1;
+    vbl.request.signal = (unsigned long) (uintptr_t) window;
+
+    if (drmWaitVBlank(_glfw.drm.fd, &vbl) != 0)
+    {
+        submitPageFlip(window);
+        return;
+    }
+
+    window->drm.flip_waiting = GLFW_TRUE;
+}
+
+// Returns the buffer on screen to the ring once it has been replaced
+//
+static void releaseScanoutBuffer(_GLFWwindow* window)
+{
+    Framebuffer* fb;
+
+    if (window->drm.scanout_buffer == -1)
+        return;
+
+    fb = &window->drm.framebuffers[window->drm.scanout_buffer];
+    if (fb->release_fence != -1)
+    {
+        close(fb->release_fence);
+        fb->release_fence = -1;
+    }
+    if (fb->render_fence != -1)
+    {
+        close(fb->render_fence);
+        fb->render_fence = -1;
+    }
+
+    // The buffer may already have been handed out for rendering behind
+    // a GPU wait on its release fence
+    if (fb->state == _GLFW_DRM_BUFFER_SCANOUT)
+        fb->state = _GLFW_DRM_BUFFER_FREE;
+
+    window->drm.scanout_buffer = -1;
+}
+
+// Converts a kernel flip timestamp to the time base of glfwGetTime
+//
+static double flipTimeToTimerTime(unsigned int sec, unsigned int usec)
+{
+    struct timespec now;
+    double age;
+
+    // Flip timestamps are taken from the monotonic clock
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    age = (double) ((int64_t) now.tv_sec - sec) +
+          (now.tv_nsec / 1e9 - usec / 1e6);
+
+    return (double) (_glfwPlatformGetTimerValue() - _glfw.timer.offset) /
+        _glfwPlatformGetTimerFrequency() - age;
+}
+
+// Records the timing of a completed flip
+//
+static void updateFrameTiming(_GLFWwindow* window, unsigned int frame,
+                              unsigned int sec, unsigned int usec)
+{
+    // The kernel counter is 32-bit, so it is extended by its difference from
+    // the previous flip to survive wrapping
+    if (window->drm.flip_count)
+        window->drm.flip_sequence += (uint32_t) (frame - window->drm.last_frame);
+    else
+        window->drm.flip_sequence = frame;
+
+    if (window->drm.target_valid &&
+        (int32_t) (frame - window->drm.flip_target) > 0)
+    {
+        window->drm.missed_frames += (uint32_t) (frame - window->drm.flip_target);
+    }
+
+    window->drm.last_frame = frame;
+    window->drm.target_valid = GLFW_FALSE;
+    window->drm.flip_time = flipTimeToTimerTime(sec, usec);
+    window->drm.flip_count++;
 }
 
-void DidPageFlip(unsigned int sec, unsigned int usec) {
-  _glfw.drm.page_flip_pending = 0;
-  Framebuffer *back_fb = &_glfw.drm.framebuffers[_glfw.drm.front_buffer ^ 1];
-  glBindFramebuffer(GL_FRAMEBUFFER, back_fb->gl_fb);
-  // callback_(back_fb.gl_fb, sec * 1000000 + usec);
-  // EGLSyncFence();
+void DidPageFlip(_GLFWwindow* window, unsigned int frame,
+                 unsigned int sec, unsigned int usec) {
+  updateFrameTiming(window, frame, sec, usec);
+
+  if (window->drm.flip_client)
+  {
+      // A client buffer on the primary plane replaces the ring on screen
+      if (!window->drm.flip_overlay)
+          releaseScanoutBuffer(window);
+
+      window->drm.flip_client = GLFW_FALSE;
+  }
+  else
+  {
+      releaseScanoutBuffer(window);
+
+      window->drm.scanout_buffer = window->drm.flip_buffer;
+      window->drm.framebuffers[window->drm.scanout_buffer].state = _GLFW_DRM_BUFFER_SCANOUT;
+      window->drm.flip_buffer = -1;
+  }
+
+  if (window->drm.queue_count)
+      schedulePageFlip(window);
+
+  if (window->drm.back_buffer == -1)
+      acquireBackBuffer(window);
 }
 
 static void OnModesetPageFlipEvent(int fd,
@@ -220,133 +696,1338 @@ static void OnModesetPageFlipEvent(int fd,
                                    unsigned int sec,
                                    unsigned int usec,
                                    void* data) {
-  DidPageFlip(sec, usec);
+  // Each CRTC completes its flips independently and reports the window that
+  // queued them
+  DidPageFlip((_GLFWwindow*) data, frame, sec, usec);
 }
 
-static void swapBuffersDRM(_GLFWwindow* window)
+static void OnVBlankEvent(int fd,
+                          unsigned int frame,
+                          unsigned int sec,
+                          unsigned int usec,
+                          void* data) {
+  // The vblank before the target of the oldest queued frame has arrived
+  _GLFWwindow* window = (_GLFWwindow*) data;
+
+  window->drm.flip_waiting = GLFW_FALSE;
+  if (window->drm.queue_count)
+    submitPageFlip(window);
+}
+
+// Dispatches the DRM events that are ready, waiting for at most the specified
+// number of milliseconds for one to arrive (-1 waits indefinitely)
+//
+static GLFWbool dispatchDRMEvents(int timeout)
 {
-  eglSwapBuffers(_glfw.egl.display, window->context.egl.surface);
+    struct pollfd fd = { _glfw.drm.fd, POLLIN, 0 };
+    drmEventContext context;
+
+    memset(&context, 0, sizeof(context));
+    context.version = DRM_EVENT_CONTEXT_VERSION;
+    context.page_flip_handler = OnModesetPageFlipEvent;
+    context.vblank_handler = OnVBlankEvent;
 
-  fd_set fds;
-  drmEventContext evctx = {};
-  evctx.version = DRM_EVENT_CONTEXT_VERSION;
-  evctx.page_flip_handler = OnModesetPageFlipEvent;
+    while (poll(&fd, 1, timeout) == -1)
+    {
+        if (errno != EINTR && errno != EAGAIN)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "DRM: Failed to poll for events: %s",
+                            strerror(errno));
+            return GLFW_FALSE;
+        }
+    }
 
-  Framebuffer *back_fb = &_glfw.drm.framebuffers[_glfw.drm.front_buffer ^ 1];
-  if (!PageFlip(back_fb->fb_id, NULL))
-    return;
+    if (fd.revents & POLLIN)
+        drmHandleEvent(_glfw.drm.fd, &context);
 
-  _glfw.drm.front_buffer ^= 1;
+    return GLFW_TRUE;
+}
 
-  _glfw.drm.page_flip_pending = 1;
-  while (_glfw.drm.page_flip_pending) {
-    FD_ZERO(&fds);
-    FD_SET(0, &fds);
-    FD_SET(_glfw.drm.fd, &fds);
-    int ret = select(_glfw.drm.fd + 1, &fds, NULL, NULL, NULL);
-    if (ret < 0) {
-      fprintf(stderr, "%m\n");
-      return;
-    } else if (ret == 0) {
-      fprintf(stderr, "select timeout!\n");
-      return;
+// Waits for a page flip to free up a buffer for the window to render to
+//
+// This returns at once if the window already has a back buffer and only
+// blocks when every buffer in its ring is either on screen or waiting to be.
+// Flips completing for other windows are processed while waiting
+//
+static void waitForBackBuffer(_GLFWwindow* window)
+{
+    while (window->drm.back_buffer == -1 && window->drm.output &&
+           _glfw.drm.active)
+    {
+        if (!dispatchDRMEvents(-1))
+            break;
     }
+}
 
-    if (FD_ISSET(0, &fds)) {
-      // Destroy();
-      printf("!??\n");
+// Waits for the flip in flight for the window, if any, to complete
+//
+static void waitForPageFlip(_GLFWwindow* window)
+{
+    while (flipPending(window))
+    {
+        if (!dispatchDRMEvents(-1))
+            break;
     }
-    if (FD_ISSET(_glfw.drm.fd, &fds)) {
-      drmHandleEvent(_glfw.drm.fd, &evctx);
+}
+
+// Waits for every buffer swapped so far for the window to reach the screen
+//
+static void waitForPageFlips(_GLFWwindow* window)
+{
+    while (flipPending(window) || window->drm.queue_count)
+    {
+        if (!dispatchDRMEvents(-1))
+            break;
     }
-  }
-  if (FD_ISSET(0, &fds)) {
-    printf("exit due to user-input\n");
-  }
 }
 
-GLFWbool CreateFramebuffer(size_t width,
-                         size_t height,
-                         Framebuffer *framebuffer) {
-  framebuffer->bo = gbm_bo_create(_glfw.drm.display, width, height, GBM_FORMAT_XRGB8888,
-                                 GBM_BO_USE_SCANOUT | GBM_BO_USE_RENDERING);
-  if (!framebuffer->bo) {
-    fprintf(stderr, "failed to create a gbm buffer.\n");
-    return GLFW_FALSE;
-  }
+// Waits for data to arrive on the DRM, input or empty event fds or any event
+// source, for at most the specified number of seconds if a timeout is given
+//
+// Returns GLFW_FALSE if the timeout elapsed or polling failed
+//
+static GLFWbool waitForEvent(double* timeout)
+{
+    struct pollfd fds[] =
+    {
+        { _glfw.drm.fd > 0 ? _glfw.drm.fd : -1, POLLIN, 0 },
+        { _glfw.drm.libinput ? libinput_get_fd(_glfw.drm.libinput) : -1, POLLIN, 0 },
+        { _glfw.drm.empty_event_fd > 0 ? _glfw.drm.empty_event_fd : -1, POLLIN, 0 },
+        { _glfw.drm.repeat_fd > 0 ? _glfw.drm.repeat_fd : -1, POLLIN, 0 }
+    };
 
-  framebuffer->fd = gbm_bo_get_fd(framebuffer->bo);
-  if (framebuffer->fd < 0) {
-    fprintf(stderr, "failed to get fb for bo: %d", framebuffer->fd);
-    return GLFW_FALSE;
-  }
+    if (!_glfwWaitEventsPOSIX(fds, sizeof(fds) / sizeof(fds[0]), timeout))
+        return GLFW_FALSE;
 
-  uint32_t handle = gbm_bo_get_handle(framebuffer->bo).u32;
-  uint32_t stride = gbm_bo_get_stride(framebuffer->bo);
-  uint32_t offset = 0;
-  drmModeAddFB2(_glfw.drm.fd, width, height, GBM_FORMAT_XRGB8888, &handle,
-                &stride, &offset, &framebuffer->fb_id, 0);
-  if (!framebuffer->fb_id) {
-    fprintf(stderr, "failed to create framebuffer from buffer object.\n");
-    return GLFW_FALSE;
-  }
+    if (fds[2].revents & POLLIN)
+    {
+        uint64_t value;
+        while (read(_glfw.drm.empty_event_fd, &value, sizeof(value)) == -1 &&
+               errno == EINTR)
+            ;
+    }
+
+    return GLFW_TRUE;
+}
+
+static void swapBuffersDRM(_GLFWwindow* window)
+{
+    Framebuffer* fb;
+
+    // Frames swapped while the VT is away are dropped and their buffer is
+    // rendered to again
+    if (!_glfw.drm.active)
+        return;
+
+    // The previous swap gives up waiting if the VT was switched away
+    waitForBackBuffer(window);
+    if (window->drm.back_buffer == -1)
+        return;
+
+    fb = &window->drm.framebuffers[window->drm.back_buffer];
+    fb->state = _GLFW_DRM_BUFFER_QUEUED;
+    fb->render_fence = createRenderFence(window);
+    if (fb->render_fence == -1)
+    {
+        // Without a fence the kernel can only wait for rendering commands it
+        // has been given, and legacy page flips may not wait at all
+        if (window->drm.output->drm.atomic)
+            glFlush();
+        else
+            glFinish();
+    }
+
+    window->drm.queue[window->drm.queue_count++] = window->drm.back_buffer;
+    window->drm.back_buffer = -1;
+
+    // Only one flip can be in flight per CRTC, so later frames wait in the
+    // queue and are flipped in order as each flip completes
+    if (!flipPending(window))
+        schedulePageFlip(window);
+
+    // The next frame needs a buffer to render to, so the swap only blocks
+    // here when the ring of this window has no free buffer left
+    acquireBackBuffer(window);
+    waitForBackBuffer(window);
+}
+
+// Records the swap interval of the current context, as presentation goes
+// through page flips instead of an EGL surface
+//
+static void swapIntervalDRM(int interval)
+{
+    _GLFWwindow* window = _glfwPlatformGetTls(&_glfw.contextSlot);
+    if (window)
+        window->drm.swap_interval = interval;
+}
+
+// Makes the back buffer of a headless window the frame available to readers
+// and returns the previous frame to the ring
+//
+// The scanout buffer of a headless window is the most recently swapped frame
+//
+static void swapBuffersHeadless(_GLFWwindow* window)
+{
+    Framebuffer* fb;
+
+    if (window->drm.back_buffer == -1)
+        return;
+
+    fb = &window->drm.framebuffers[window->drm.back_buffer];
+    fb->render_fence = createRenderFence(window);
+    if (fb->render_fence == -1)
+        glFinish();
+
+    releaseScanoutBuffer(window);
+
+    fb->state = _GLFW_DRM_BUFFER_SCANOUT;
+    window->drm.scanout_buffer = window->drm.back_buffer;
+    window->drm.back_buffer = -1;
+
+    acquireBackBuffer(window);
+}
+
+GLFWbool CreateFramebuffer(_GLFWwindow* window,
+                         size_t width,
+                         size_t height,
+                         Framebuffer *framebuffer) {
+  int i, planes, ret;
+  int n = 0;
+  EGLint attribs[48];
+  uint32_t handles[4] = {0}, strides[4] = {0}, offsets[4] = {0};
+  uint64_t modifiers[4] = {0};
+  uint64_t modifier = DRM_FORMAT_MOD_INVALID;
+  const uint32_t format = window->drm.format;
+  static const EGLint planeAttribs[4][5] = {
+    {EGL_DMA_BUF_PLANE0_FD_EXT, EGL_DMA_BUF_PLANE0_OFFSET_EXT, EGL_DMA_BUF_PLANE0_PITCH_EXT,
+     EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT, EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE1_FD_EXT, EGL_DMA_BUF_PLANE1_OFFSET_EXT, EGL_DMA_BUF_PLANE1_PITCH_EXT,
+     EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT, EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE2_FD_EXT, EGL_DMA_BUF_PLANE2_OFFSET_EXT, EGL_DMA_BUF_PLANE2_PITCH_EXT,
+     EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT, EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE3_FD_EXT, EGL_DMA_BUF_PLANE3_OFFSET_EXT, EGL_DMA_BUF_PLANE3_PITCH_EXT,
+     EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT, EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT}
+  };
+
+  if (window->drm.modifier_count) {
+    // The driver picks the most efficient of the layouts, such as tiled or
+    // compressed ones, that the primary plane can scan out
+    framebuffer->bo = gbm_bo_create_with_modifiers(_glfw.drm.display, width, height, format,
+                                                   window->drm.modifiers,
+                                                   window->drm.modifier_count);
+    if (framebuffer->bo)
+      modifier = gbm_bo_get_modifier(framebuffer->bo);
+  }
+
+  if (!framebuffer->bo) {
+    // Buffers shared with a separate display controller must be linear, as it
+    // cannot be assumed to understand the tiling of the render device, and so
+    // must headless buffers, as they are read directly by the application
+    const uint32_t usage = _glfw.drm.render_fd > 0 || window->drm.headless ?
+      GBM_BO_USE_RENDERING | GBM_BO_USE_LINEAR :
+      GBM_BO_USE_SCANOUT | GBM_BO_USE_RENDERING;
+
+    framebuffer->bo = gbm_bo_create(_glfw.drm.display, width, height, format,
+                                   usage);
+  }
+
+  if (!framebuffer->bo) {
+    _glfwInputError(GLFW_PLATFORM_ERROR, "DRM: Failed to create GBM buffer");
+    return GLFW_FALSE;
+  }
+
+  framebuffer->fd = gbm_bo_get_fd(framebuffer->bo);
+  if (framebuffer->fd < 0) {
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "DRM: Failed to export GBM buffer as dma-buf");
+    return GLFW_FALSE;
+  }
+
+  if (_glfw.drm.render_fd > 0 && !window->drm.headless) {
+    // The GEM handle belongs to the render node, so the buffer is imported
+    // into the scanout device through its dma-buf
+    if (drmPrimeFDToHandle(_glfw.drm.fd, framebuffer->fd, &framebuffer->prime_handle)) {
+      _glfwInputError(GLFW_PLATFORM_ERROR,
+                      "DRM: Failed to import buffer into scanout device: %s",
+                      strerror(errno));
+      return GLFW_FALSE;
+    }
+  }
+
+  planes = gbm_bo_get_plane_count(framebuffer->bo);
+  if (planes < 1 || planes > 4)
+    planes = 1;
+
+  for (i = 0; i < planes; i++) {
+    if (framebuffer->prime_handle)
+      handles[i] = framebuffer->prime_handle;
+    else
+      handles[i] = gbm_bo_get_handle_for_plane(framebuffer->bo, i).u32;
+    strides[i] = gbm_bo_get_stride_for_plane(framebuffer->bo, i);
+    offsets[i] = gbm_bo_get_offset(framebuffer->bo, i);
+    modifiers[i] = modifier;
+  }
+
+  // Headless buffers are never scanned out
+  if (window->drm.headless)
+    ret = 0;
+  else if (modifier != DRM_FORMAT_MOD_INVALID)
+    ret = drmModeAddFB2WithModifiers(_glfw.drm.fd, width, height, format, handles,
+                                     strides, offsets, modifiers, &framebuffer->fb_id,
+                                     DRM_MODE_FB_MODIFIERS);
+  else
+    ret = drmModeAddFB2(_glfw.drm.fd, width, height, format, handles,
+                        strides, offsets, &framebuffer->fb_id, 0);
+  if (ret || (!framebuffer->fb_id && !window->drm.headless)) {
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "DRM: Failed to create framebuffer from GBM buffer: %s",
+                    strerror(errno));
+    return GLFW_FALSE;
+  }
+
+  attribs[n++] = EGL_WIDTH;
+  attribs[n++] = width;
+  attribs[n++] = EGL_HEIGHT;
+  attribs[n++] = height;
+  attribs[n++] = EGL_LINUX_DRM_FOURCC_EXT;
+  attribs[n++] = format;
+
+  // Every plane of a GBM buffer lives in the same dma-buf
+  for (i = 0; i < planes; i++) {
+    attribs[n++] = planeAttribs[i][0];
+    attribs[n++] = framebuffer->fd;
+    attribs[n++] = planeAttribs[i][1];
+    attribs[n++] = offsets[i];
+    attribs[n++] = planeAttribs[i][2];
+    attribs[n++] = strides[i];
+
+    if (modifier != DRM_FORMAT_MOD_INVALID) {
+      attribs[n++] = planeAttribs[i][3];
+      attribs[n++] = (EGLint) (modifier & 0xffffffff);
+      attribs[n++] = planeAttribs[i][4];
+      attribs[n++] = (EGLint) (modifier >> 32);
+    }
+  }
+
+  attribs[n++] = EGL_NONE;
+
+  framebuffer->image =
+      eglCreateImageKHR(_glfw.egl.display, EGL_NO_CONTEXT, EGL_LINUX_DMA_BUF_EXT,
+                          NULL /* no client buffer */, attribs);
+  if (framebuffer->image == EGL_NO_IMAGE_KHR) {
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "DRM: Failed to create EGL image from GBM buffer: 0x%x",
+                    eglGetError());
+    return GLFW_FALSE;
+  }
+
+  glGenTextures(1, &framebuffer->gl_tex);
+  glBindTexture(GL_TEXTURE_2D, framebuffer->gl_tex);
+  glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, framebuffer->image);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  glGenFramebuffers(1, &framebuffer->gl_fb);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer->gl_fb);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         framebuffer->gl_tex, 0);
+
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "DRM: Framebuffer for GBM buffer is incomplete: 0x%x",
+                    glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    glDeleteFramebuffers(1, &framebuffer->gl_fb);
+    glDeleteTextures(1, &framebuffer->gl_tex);
+    return GLFW_FALSE;
+  }
+
+  return GLFW_TRUE;
+}
+
+// Releases the GL, EGL and KMS objects of the framebuffer
+//
+// The context of the window owning the framebuffer must be current
+//
+static void destroyFramebuffer(Framebuffer* framebuffer)
+{
+    if (framebuffer->render_fence != -1)
+        close(framebuffer->render_fence);
+    if (framebuffer->release_fence != -1)
+        close(framebuffer->release_fence);
+
+    if (framebuffer->gl_fb)
+        glDeleteFramebuffers(1, &framebuffer->gl_fb);
+    if (framebuffer->gl_tex)
+        glDeleteTextures(1, &framebuffer->gl_tex);
+    if (framebuffer->image != EGL_NO_IMAGE_KHR && _glfw.drm.egl.DestroyImageKHR)
+        _glfw.drm.egl.DestroyImageKHR(_glfw.egl.display, framebuffer->image);
+
+    if (framebuffer->fb_id)
+        drmModeRmFB(_glfw.drm.fd, framebuffer->fb_id);
+    if (framebuffer->prime_handle)
+    {
+        struct drm_gem_close args = { framebuffer->prime_handle, 0 };
+        drmIoctl(_glfw.drm.fd, DRM_IOCTL_GEM_CLOSE, &args);
+    }
+    if (framebuffer->fd > 0)
+        close(framebuffer->fd);
+    if (framebuffer->bo)
+        gbm_bo_destroy(framebuffer->bo);
+
+    memset(framebuffer, 0, sizeof(Framebuffer));
+    framebuffer->render_fence = -1;
+    framebuffer->release_fence = -1;
+}
+
+GLFWbool ModeSetCrtc(_GLFWmonitor* monitor, uint32_t fb_id) {
+  /* remember what was on screen so it can be restored */
+  if (!monitor->drm.saved_crtc)
+    monitor->drm.saved_crtc = drmModeGetCrtc(_glfw.drm.fd, monitor->drm.crtc);
+
+  if (monitor->drm.atomic) {
+    if (modesetAtomic(monitor, fb_id))
+      return GLFW_TRUE;
+
+    // Fall back to legacy modesetting for the lifetime of the monitor
+    monitor->drm.atomic = GLFW_FALSE;
+  }
+
+  int ret = drmModeSetCrtc(_glfw.drm.fd, monitor->drm.crtc, fb_id, 0, 0,
+                           &monitor->drm.conn, 1, &monitor->drm.mode);
+  if (ret) {
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "DRM: Failed to set CRTC for connector %u: %s",
+                    monitor->drm.conn, strerror(errno));
+    return GLFW_FALSE;
+  }
+  return GLFW_TRUE;
+}
+
+// Enables or disables variable refresh rate on the CRTC of the monitor, if
+// the display supports it
+//
+static void setAdaptiveSync(_GLFWmonitor* monitor, GLFWbool enabled)
+{
+    if (!monitor->drm.vrr_capable || monitor->drm.vrr_enabled == enabled)
+        return;
+
+    if (drmModeObjectSetProperty(_glfw.drm.fd, monitor->drm.crtc,
+                                 DRM_MODE_OBJECT_CRTC,
+                                 monitor->drm.vrr_enabled_prop, enabled) == 0)
+    {
+        monitor->drm.vrr_enabled = enabled;
+    }
+}
+
+// Puts back what was on screen before the window took over the monitor
+//
+static void restoreCrtc(_GLFWmonitor* monitor)
+{
+    drmModeCrtc* crtc = monitor->drm.saved_crtc;
+    if (!crtc)
+        return;
+
+    setAdaptiveSync(monitor, GLFW_FALSE);
+
+    // The saved state is kept, as it is restored again on every VT switch
+    drmModeSetCrtc(_glfw.drm.fd, crtc->crtc_id, crtc->buffer_id,
+                   crtc->x, crtc->y, &monitor->drm.conn, 1, &crtc->mode);
+}
+
+
+// Returns whether the screen position is on the monitor the window is on
+//
+static GLFWbool windowContainsPoint(_GLFWwindow* window, double x, double y)
+{
+    const _GLFWmonitor* monitor = window->drm.output;
+
+    if (!monitor)
+        return GLFW_FALSE;
+
+    return x >= monitor->drm.xpos &&
+           y >= monitor->drm.ypos &&
+           x < monitor->drm.xpos + monitor->drm.mode.hdisplay &&
+           y < monitor->drm.ypos + monitor->drm.mode.vdisplay;
+}
+
+// Returns the window receiving input, which is the one on the monitor the
+// pointer is on
+//
+static _GLFWwindow* getInputWindow(void)
+{
+    _GLFWwindow* window;
+
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        if (windowContainsPoint(window, _glfw.drm.cursor_x, _glfw.drm.cursor_y))
+            return window;
+    }
+
+    // Headless windows never receive input
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        if (window->drm.output)
+            return window;
+    }
+
+    return NULL;
+}
+
+// Retrieves the size of the virtual screen spanning all monitors
+//
+static void getScreenSize(double* width, double* height)
+{
+    int i;
+
+    *width = *height = 0.0;
+
+    for (i = 0;  i < _glfw.monitorCount;  i++)
+    {
+        const _GLFWmonitor* monitor = _glfw.monitors[i];
+        const double right = monitor->drm.xpos + monitor->drm.mode.hdisplay;
+        const double bottom = monitor->drm.ypos + monitor->drm.mode.vdisplay;
+
+        if (right > *width)
+            *width = right;
+        if (bottom > *height)
+            *height = bottom;
+    }
+}
+
+// Reports the pointer position relative to the window
+//
+static void inputCursorPos(_GLFWwindow* window)
+{
+    _glfwInputCursorPos(window,
+                        _glfw.drm.cursor_x - window->drm.output->drm.xpos,
+                        _glfw.drm.cursor_y - window->drm.output->drm.ypos);
+}
+
+// Shows the specified cursor on the monitor, or hides it if NULL
+//
+static void setMonitorCursor(_GLFWmonitor* monitor, const _GLFWcursorDRM* cursor)
+{
+    if (monitor->drm.cursor == cursor)
+        return;
+
+    if (cursor)
+    {
+        drmModeSetCursor2(_glfw.drm.fd, monitor->drm.crtc,
+                          gbm_bo_get_handle(cursor->bo).u32,
+                          _glfw.drm.cursor_width, _glfw.drm.cursor_height,
+                          cursor->xhot, cursor->yhot);
+    }
+    else
+        drmModeSetCursor(_glfw.drm.fd, monitor->drm.crtc, 0, 0, 0);
+
+    monitor->drm.cursor = cursor;
+}
+
+// Shows the cursor of the window under the pointer on the cursor plane of its
+// monitor and hides the cursor on every other monitor
+//
+// The cursor image is only uploaded when it changes, so pointer motion costs
+// a single cursor move and never requires the window to be redrawn
+//
+static void updateCursor(void)
+{
+    int i;
+
+    // The cursor planes belong to another session while the VT is away
+    if (!_glfw.drm.active)
+        return;
+
+    for (i = 0;  i < _glfw.monitorCount;  i++)
+    {
+        _GLFWmonitor* monitor = _glfw.monitors[i];
+        _GLFWwindow* window = monitor->drm.window;
+        const _GLFWcursorDRM* cursor = NULL;
+
+        if (window && window->cursorMode == GLFW_CURSOR_NORMAL &&
+            windowContainsPoint(window, _glfw.drm.cursor_x, _glfw.drm.cursor_y))
+        {
+            if (window->cursor)
+                cursor = &window->cursor->drm;
+            else if (_glfw.drm.default_cursor.bo)
+                cursor = &_glfw.drm.default_cursor;
+        }
+
+        setMonitorCursor(monitor, cursor);
+
+        if (cursor)
+        {
+            drmModeMoveCursor(_glfw.drm.fd, monitor->drm.crtc,
+                              (int) _glfw.drm.cursor_x - monitor->drm.xpos - cursor->xhot,
+                              (int) _glfw.drm.cursor_y - monitor->drm.ypos - cursor->yhot);
+        }
+    }
+}
+
+// Creates a cursor plane buffer from the specified image
+//
+static GLFWbool createCursor(_GLFWcursorDRM* cursor, const GLFWimage* image,
+                             int xhot, int yhot)
+{
+    int x, y;
+    uint32_t* pixels;
+    const int width = _glfw.drm.cursor_width;
+    const int height = _glfw.drm.cursor_height;
+
+    if (!_glfw.drm.cursor_device)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Hardware cursors are not available");
+        return GLFW_FALSE;
+    }
+
+    if (image->width > width || image->height > height)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Cursor images must not exceed %ix%i pixels",
+                        width, height);
+        return GLFW_FALSE;
+    }
+
+    cursor->bo = gbm_bo_create(_glfw.drm.cursor_device, width, height,
+                               GBM_FORMAT_ARGB8888,
+                               GBM_BO_USE_CURSOR | GBM_BO_USE_WRITE);
+    if (!cursor->bo)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to create cursor buffer");
+        return GLFW_FALSE;
+    }
+
+    // The cursor plane is always its full size, so the image is padded with
+    // transparent pixels
+    pixels = calloc(width * height, sizeof(uint32_t));
+    if (!pixels)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        gbm_bo_destroy(cursor->bo);
+        cursor->bo = NULL;
+        return GLFW_FALSE;
+    }
+
+    for (y = 0;  y < image->height;  y++)
+    {
+        for (x = 0;  x < image->width;  x++)
+        {
+            const unsigned char* source = image->pixels + (y * image->width + x) * 4;
+            const uint32_t alpha = source[3];
+
+            // Cursor planes expect premultiplied alpha
+            pixels[y * width + x] = (alpha << 24) |
+                                    ((source[0] * alpha / 255) << 16) |
+                                    ((source[1] * alpha / 255) << 8) |
+                                    (source[2] * alpha / 255);
+        }
+    }
+
+    if (gbm_bo_write(cursor->bo, pixels, width * height * sizeof(uint32_t)) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to upload cursor image");
+        free(pixels);
+        gbm_bo_destroy(cursor->bo);
+        cursor->bo = NULL;
+        return GLFW_FALSE;
+    }
+
+    free(pixels);
+
+    cursor->xhot = xhot;
+    cursor->yhot = yhot;
+    return GLFW_TRUE;
+}
+
+// Destroys the cursor plane buffer, hiding it first wherever it is shown
+//
+static void destroyCursor(_GLFWcursorDRM* cursor)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.monitorCount;  i++)
+    {
+        if (_glfw.monitors[i]->drm.cursor == cursor)
+            setMonitorCursor(_glfw.monitors[i], NULL);
+    }
+
+    if (cursor->bo)
+        gbm_bo_destroy(cursor->bo);
+
+    cursor->bo = NULL;
+}
+
+// Returns whether the pixel is part of the specified standard cursor shape
+//
+static GLFWbool standardCursorContains(int shape, int x, int y)
+{
+    const int dx = abs(x - 16), dy = abs(y - 16);
+
+    switch (shape)
+    {
+        case GLFW_IBEAM_CURSOR:
+            return (x == 16 && y >= 6 && y <= 26) ||
+                   ((y == 6 || y == 26) && dx <= 3);
+        case GLFW_CROSSHAIR_CURSOR:
+            return (x == 16 && y >= 6 && y <= 26) ||
+                   (y == 16 && x >= 6 && x <= 26);
+        case GLFW_HRESIZE_CURSOR:
+            return x >= 6 && x <= 26 && dy <= (dx >= 6 ? 10 - dx : 0);
+        case GLFW_VRESIZE_CURSOR:
+            return y >= 6 && y <= 26 && dx <= (dy >= 6 ? 10 - dy : 0);
+        default:
+            // The hand has no simple outline and shares the arrow
+            return x >= 1 && x - 1 <= y - 1 && (x - 1) + (y - 1) <= 22;
+    }
+}
+
+// Creates a standard cursor drawn as a white shape with a black outline
+//
+static GLFWbool createStandardCursor(_GLFWcursorDRM* cursor, int shape)
+{
+    int x, y;
+    GLFWbool result;
+    unsigned char pixels[32 * 32 * 4];
+    const GLFWimage image = { 32, 32, pixels };
+
+    for (y = 0;  y < 32;  y++)
+    {
+        for (x = 0;  x < 32;  x++)
+        {
+            unsigned char* target = pixels + (y * 32 + x) * 4;
+
+            if (standardCursorContains(shape, x, y))
+                memset(target, 0xff, 4);
+            else if (standardCursorContains(shape, x - 1, y) ||
+                     standardCursorContains(shape, x + 1, y) ||
+                     standardCursorContains(shape, x, y - 1) ||
+                     standardCursorContains(shape, x, y + 1))
+            {
+                target[0] = target[1] = target[2] = 0;
+                target[3] = 0xff;
+            }
+            else
+                memset(target, 0, 4);
+        }
+    }
+
+    if (shape == GLFW_ARROW_CURSOR || shape == GLFW_HAND_CURSOR)
+        result = createCursor(cursor, &image, 1, 1);
+    else
+        result = createCursor(cursor, &image, 16, 16);
+
+    return result;
+}
+
+static int translateKey(uint32_t scancode)
+{
+    if (scancode < sizeof(_glfw.drm.keycodes) / sizeof(_glfw.drm.keycodes[0]))
+        return _glfw.drm.keycodes[scancode];
+
+    return GLFW_KEY_UNKNOWN;
+}
+
+// Updates the modifier bits from a modifier key event
+//
+static void updateKeyMods(int key, int action)
+{
+    int mod;
+
+    switch (key)
+    {
+        case GLFW_KEY_LEFT_SHIFT:
+        case GLFW_KEY_RIGHT_SHIFT:
+            mod = GLFW_MOD_SHIFT;
+            break;
+        case GLFW_KEY_LEFT_CONTROL:
+        case GLFW_KEY_RIGHT_CONTROL:
+            mod = GLFW_MOD_CONTROL;
+            break;
+        case GLFW_KEY_LEFT_ALT:
+        case GLFW_KEY_RIGHT_ALT:
+            mod = GLFW_MOD_ALT;
+            break;
+        case GLFW_KEY_LEFT_SUPER:
+        case GLFW_KEY_RIGHT_SUPER:
+            mod = GLFW_MOD_SUPER;
+            break;
+        case GLFW_KEY_CAPS_LOCK:
+            if (action == GLFW_PRESS)
+                _glfw.drm.modifiers ^= GLFW_MOD_CAPS_LOCK;
+            return;
+        case GLFW_KEY_NUM_LOCK:
+            if (action == GLFW_PRESS)
+                _glfw.drm.modifiers ^= GLFW_MOD_NUM_LOCK;
+            return;
+        default:
+            return;
+    }
+
+    if (action == GLFW_PRESS)
+        _glfw.drm.modifiers |= mod;
+    else
+        _glfw.drm.modifiers &= ~mod;
+}
+
+// Moves the shared pointer to the specified screen position, clamped to the
+// virtual screen
+//
+static void setCursorPosition(double x, double y)
+{
+    double width, height;
+
+    getScreenSize(&width, &height);
+
+    if (x > width - 1.0)
+        x = width - 1.0;
+    if (y > height - 1.0)
+        y = height - 1.0;
+
+    _glfw.drm.cursor_x = x < 0.0 ? 0.0 : x;
+    _glfw.drm.cursor_y = y < 0.0 ? 0.0 : y;
+
+    updateCursor();
+}
+
+// Starts repeating the specified key, or stops repeating if the scancode is -1
+//
+static void setKeyRepeat(int key, int scancode)
+{
+    struct itimerspec timer = { { 0, 0 }, { 0, 0 } };
+
+    if (scancode != -1)
+    {
+        timer.it_interval.tv_sec = _GLFW_DRM_REPEAT_INTERVAL / 1000;
+        timer.it_interval.tv_nsec = (_GLFW_DRM_REPEAT_INTERVAL % 1000) * 1000000;
+        timer.it_value.tv_sec = _GLFW_DRM_REPEAT_DELAY / 1000;
+        timer.it_value.tv_nsec = (_GLFW_DRM_REPEAT_DELAY % 1000) * 1000000;
+    }
+
+    _glfw.drm.repeat_key = key;
+    _glfw.drm.repeat_scancode = scancode;
+    timerfd_settime(_glfw.drm.repeat_fd, 0, &timer, NULL);
+}
+
+// Reports the text produced by the specified key in the current layout state
+//
+static void inputChar(_GLFWwindow* window, int scancode)
+{
+    const uint32_t codepoint =
+        xkb_state_key_get_utf32(_glfw.drm.xkb.state, scancode + 8);
+
+    // Control characters are reported only as key events
+    if (codepoint >= 0x20 && codepoint != 0x7f)
+    {
+        const int mods = _glfw.drm.modifiers;
+        const int plain = !(mods & (GLFW_MOD_CONTROL | GLFW_MOD_ALT));
+        _glfwInputChar(window, codepoint, mods, plain);
+    }
+}
+
+static void handleKeyboardEvent(struct libinput_event_keyboard* event)
+{
+    _GLFWwindow* window = getInputWindow();
+    const uint32_t scancode = libinput_event_keyboard_get_key(event);
+    const int key = translateKey(scancode);
+    const int action =
+        libinput_event_keyboard_get_key_state(event) == LIBINPUT_KEY_STATE_PRESSED
+        ? GLFW_PRESS : GLFW_RELEASE;
+
+    updateKeyMods(key, action);
+
+    // Evdev codes are offset by eight in XKB keymaps
+    xkb_state_update_key(_glfw.drm.xkb.state, scancode + 8,
+                         action == GLFW_PRESS ? XKB_KEY_DOWN : XKB_KEY_UP);
+
+    if (action == GLFW_PRESS)
+    {
+        if (xkb_keymap_key_repeats(_glfw.drm.xkb.keymap, scancode + 8))
+            setKeyRepeat(key, scancode);
+        else
+            setKeyRepeat(GLFW_KEY_UNKNOWN, -1);
+    }
+    else if ((int) scancode == _glfw.drm.repeat_scancode)
+        setKeyRepeat(GLFW_KEY_UNKNOWN, -1);
+
+    if (window)
+    {
+        _glfwInputKey(window, key, scancode, action, _glfw.drm.modifiers);
+        if (action == GLFW_PRESS)
+            inputChar(window, scancode);
+    }
+}
+
+// Reports a repeat of the held key for every expiration of the repeat timer
+//
+static void handleKeyRepeat(void)
+{
+    uint64_t repeats;
+    _GLFWwindow* window;
+
+    if (read(_glfw.drm.repeat_fd, &repeats, sizeof(repeats)) != sizeof(repeats))
+        return;
+
+    window = getInputWindow();
+    if (!window || _glfw.drm.repeat_scancode == -1)
+        return;
+
+    while (repeats--)
+    {
+        _glfwInputKey(window, _glfw.drm.repeat_key, _glfw.drm.repeat_scancode,
+                      GLFW_REPEAT, _glfw.drm.modifiers);
+        inputChar(window, _glfw.drm.repeat_scancode);
+    }
+}
+
+static void handlePointerMotion(double dx, double dy)
+{
+    _GLFWwindow* window = getInputWindow();
+
+    if (window && window->cursorMode == GLFW_CURSOR_DISABLED)
+    {
+        _glfwInputCursorPos(window,
+                            window->virtualCursorPosX + dx,
+                            window->virtualCursorPosY + dy);
+        return;
+    }
+
+    setCursorPosition(_glfw.drm.cursor_x + dx, _glfw.drm.cursor_y + dy);
+
+    // The pointer may have moved onto the monitor of another window
+    window = getInputWindow();
+    if (window)
+        inputCursorPos(window);
+}
+
+static void handlePointerEvent(struct libinput_event* event)
+{
+    _GLFWwindow* window = getInputWindow();
+    struct libinput_event_pointer* pointer =
+        libinput_event_get_pointer_event(event);
+
+    switch (libinput_event_get_type(event))
+    {
+        case LIBINPUT_EVENT_POINTER_MOTION:
+        {
+            handlePointerMotion(libinput_event_pointer_get_dx(pointer),
+                                libinput_event_pointer_get_dy(pointer));
+            break;
+        }
+
+        case LIBINPUT_EVENT_POINTER_MOTION_ABSOLUTE:
+        {
+            double width, height, x, y;
+
+            getScreenSize(&width, &height);
+            x = libinput_event_pointer_get_absolute_x_transformed(pointer, width);
+            y = libinput_event_pointer_get_absolute_y_transformed(pointer, height);
+
+            handlePointerMotion(x - _glfw.drm.cursor_x, y - _glfw.drm.cursor_y);
+            break;
+        }
+
+        case LIBINPUT_EVENT_POINTER_BUTTON:
+        {
+            const uint32_t button = libinput_event_pointer_get_button(pointer);
+            const int action =
+                libinput_event_pointer_get_button_state(pointer) ==
+                    LIBINPUT_BUTTON_STATE_PRESSED ? GLFW_PRESS : GLFW_RELEASE;
+
+            // Makes left, right and middle 0, 1 and 2, with the remaining
+            // buttons following evdev order
+            if (window && button >= BTN_LEFT &&
+                button - BTN_LEFT <= GLFW_MOUSE_BUTTON_LAST)
+            {
+                _glfwInputMouseClick(window, button - BTN_LEFT, action,
+                                     _glfw.drm.modifiers);
+            }
+            break;
+        }
+
+        case LIBINPUT_EVENT_POINTER_AXIS:
+        {
+            // libinput reports wheel rotation in degrees, with one step of
+            // a typical wheel being 15 degrees
+            const double scrollFactor = 1.0 / 15.0;
+            double x = 0.0, y = 0.0;
+
+            if (libinput_event_pointer_has_axis(pointer,
+                    LIBINPUT_POINTER_AXIS_SCROLL_HORIZONTAL))
+            {
+                x = libinput_event_pointer_get_axis_value(pointer,
+                        LIBINPUT_POINTER_AXIS_SCROLL_HORIZONTAL) * scrollFactor;
+            }
+
+            if (libinput_event_pointer_has_axis(pointer,
+                    LIBINPUT_POINTER_AXIS_SCROLL_VERTICAL))
+            {
+                y = -libinput_event_pointer_get_axis_value(pointer,
+                        LIBINPUT_POINTER_AXIS_SCROLL_VERTICAL) * scrollFactor;
+            }
+
+            if (window)
+                _glfwInputScroll(window, x, y);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+// Emulates the pointer with the first touch point, as there is no touch API
+//
+static void handleTouchEvent(struct libinput_event* event)
+{
+    _GLFWwindow* window = getInputWindow();
+    struct libinput_event_touch* touch = libinput_event_get_touch_event(event);
+    const enum libinput_event_type type = libinput_event_get_type(event);
+    double width, height;
+    int32_t slot;
+
+    if (type == LIBINPUT_EVENT_TOUCH_FRAME)
+        return;
+
+    if (type == LIBINPUT_EVENT_TOUCH_CANCEL)
+    {
+        if (_glfw.drm.touch_slot != -1 && window)
+        {
+            _glfwInputMouseClick(window, GLFW_MOUSE_BUTTON_LEFT, GLFW_RELEASE,
+                                 _glfw.drm.modifiers);
+        }
+
+        _glfw.drm.touch_slot = -1;
+        return;
+    }
+
+    slot = libinput_event_touch_get_slot(touch);
+
+    if (type == LIBINPUT_EVENT_TOUCH_DOWN && _glfw.drm.touch_slot == -1)
+        _glfw.drm.touch_slot = slot;
+
+    if (slot != _glfw.drm.touch_slot)
+        return;
+
+    if (type == LIBINPUT_EVENT_TOUCH_UP)
+    {
+        _glfw.drm.touch_slot = -1;
+
+        if (window)
+        {
+            _glfwInputMouseClick(window, GLFW_MOUSE_BUTTON_LEFT, GLFW_RELEASE,
+                                 _glfw.drm.modifiers);
+        }
+        return;
+    }
+
+    getScreenSize(&width, &height);
+    setCursorPosition(libinput_event_touch_get_x_transformed(touch, width),
+                      libinput_event_touch_get_y_transformed(touch, height));
+
+    window = getInputWindow();
+    if (window)
+    {
+        inputCursorPos(window);
+
+        if (type == LIBINPUT_EVENT_TOUCH_DOWN)
+        {
+            _glfwInputMouseClick(window, GLFW_MOUSE_BUTTON_LEFT, GLFW_PRESS,
+                                 _glfw.drm.modifiers);
+        }
+    }
+}
+
+// Reads from the libinput fd and processes every event that has been queued
+//
+static void handleInputEvents(void)
+{
+    struct libinput_event* event;
+
+    if (!_glfw.drm.libinput)
+        return;
+
+    libinput_dispatch(_glfw.drm.libinput);
+
+    while ((event = libinput_get_event(_glfw.drm.libinput)))
+    {
+        switch (libinput_event_get_type(event))
+        {
+            case LIBINPUT_EVENT_KEYBOARD_KEY:
+                handleKeyboardEvent(libinput_event_get_keyboard_event(event));
+                break;
+
+            case LIBINPUT_EVENT_POINTER_MOTION:
+            case LIBINPUT_EVENT_POINTER_MOTION_ABSOLUTE:
+            case LIBINPUT_EVENT_POINTER_BUTTON:
+            case LIBINPUT_EVENT_POINTER_AXIS:
+                handlePointerEvent(event);
+                break;
+
+            case LIBINPUT_EVENT_TOUCH_DOWN:
+            case LIBINPUT_EVENT_TOUCH_UP:
+            case LIBINPUT_EVENT_TOUCH_MOTION:
+            case LIBINPUT_EVENT_TOUCH_CANCEL:
+            case LIBINPUT_EVENT_TOUCH_FRAME:
+                handleTouchEvent(event);
+                break;
+
+            default:
+                break;
+        }
+
+        libinput_event_destroy(event);
+    }
+}
+
+// Turns off the overlay and cursor planes of a monitor no longer showing a
+// window and restores what was on screen before GLFW took it over
+//
+static void releaseMonitor(_GLFWmonitor* monitor)
+{
+    if (monitor->drm.overlay)
+    {
+        drmModeSetPlane(_glfw.drm.fd, monitor->drm.overlay, 0, 0, 0,
+                        0, 0, 0, 0, 0, 0, 0, 0);
+    }
+
+    setMonitorCursor(monitor, NULL);
+    restoreCrtc(monitor);
+}
+
+// Hands the display over to another session when the VT is switched away
+// from, and takes it back and restores every window when switched back to
+//
+// Windows are reported as iconified and unfocused while the display is away,
+// so applications can stop rendering
+//
+static void handleVTSwitch(void)
+{
+    int i;
+    _GLFWwindow* window;
+
+    if (_glfw.drm.vt_release)
+    {
+        _glfw.drm.vt_release = 0;
+
+        if (_glfw.drm.active)
+        {
+            for (window = _glfw.windowListHead;  window;  window = window->next)
+            {
+                if (!window->drm.output)
+                    continue;
+
+                // Flips cannot complete once the display has been given up
+                waitForPageFlips(window);
+                if (window->drm.back_buffer == -1)
+                    acquireBackBuffer(window);
+
+                restoreCrtc(window->drm.output);
+            }
+
+            for (i = 0;  i < _glfw.monitorCount;  i++)
+                setMonitorCursor(_glfw.monitors[i], NULL);
+
+            drmDropMaster(_glfw.drm.fd);
+            libinput_suspend(_glfw.drm.libinput);
+            // Keys held now are released without events reaching us
+            setKeyRepeat(GLFW_KEY_UNKNOWN, -1);
+            _glfw.drm.active = GLFW_FALSE;
+
+            for (window = _glfw.windowListHead;  window;  window = window->next)
+            {
+                if (!window->drm.output)
+                    continue;
+
+                _glfwInputWindowFocus(window, GLFW_FALSE);
+                _glfwInputWindowIconify(window, GLFW_TRUE);
+            }
+        }
+
+        ioctl(_glfw.drm.tty_fd, VT_RELDISP, 1);
+    }
+
+    if (_glfw.drm.vt_acquire)
+    {
+        _glfw.drm.vt_acquire = 0;
+
+        ioctl(_glfw.drm.tty_fd, VT_RELDISP, VT_ACKACQ);
+
+        if (!_glfw.drm.active)
+        {
+            // Without master no modeset or flip can succeed, so the display
+            // stays given up and windows remain iconified
+            if (drmSetMaster(_glfw.drm.fd) != 0)
+            {
+                _glfwInputError(GLFW_PLATFORM_ERROR,
+                                "DRM: Failed to become DRM master again: %s",
+                                strerror(errno));
+                return;
+            }
+
+            libinput_resume(_glfw.drm.libinput);
+            _glfw.drm.active = GLFW_TRUE;
+
+            for (window = _glfw.windowListHead;  window;  window = window->next)
+            {
+                int index = window->drm.scanout_buffer;
+
+                if (!window->drm.output)
+                    continue;
+
+                // Without a ring buffer on screen the back buffer is shown
+                // until the next frame replaces it
+                if (index == -1)
+                    index = window->drm.back_buffer;
+
+                if (index != -1 &&
+                    ModeSetCrtc(window->drm.output,
+                                window->drm.framebuffers[index].fb_id))
+                {
+                    setAdaptiveSync(window->drm.output, window->drm.adaptive_sync);
+                }
+
+                _glfwInputWindowIconify(window, GLFW_FALSE);
+                _glfwInputWindowFocus(window, GLFW_TRUE);
+            }
+
+            // Monitors whose window was destroyed while the VT was away
+            for (i = 0;  i < _glfw.monitorCount;  i++)
+            {
+                _GLFWmonitor* monitor = _glfw.monitors[i];
+                if (!monitor->drm.release_pending)
+                    continue;
+
+                monitor->drm.release_pending = GLFW_FALSE;
+                if (!monitor->drm.window)
+                    releaseMonitor(monitor);
+            }
+
+            updateCursor();
+        }
+    }
+}
+
+
+// Chooses the format of the scanout buffers of the window and the layouts
+// the primary plane of its monitor can scan out in that format
+//
+static void chooseBufferFormat(_GLFWwindow* window, GLFWbool deepColor)
+{
+    _GLFWmonitor* monitor = window->drm.output;
+
+    free(window->drm.modifiers);
+    window->drm.modifiers = NULL;
+    window->drm.modifier_count = 0;
+
+    // Deep color is used when it was requested and the primary plane can scan
+    // it out
+    window->drm.format = GBM_FORMAT_XRGB8888;
+    if (deepColor)
+        window->drm.format = GBM_FORMAT_XRGB2101010;
+
+    if (monitor &&
+        !_glfwGetFormatModifiersDRM(monitor, window->drm.format,
+                                    &window->drm.modifiers,
+                                    &window->drm.modifier_count))
+    {
+        window->drm.format = GBM_FORMAT_XRGB8888;
+        _glfwGetFormatModifiersDRM(monitor, window->drm.format,
+                                   &window->drm.modifiers,
+                                   &window->drm.modifier_count);
+    }
+
+    // Layouts chosen by the render device cannot be assumed to be understood
+    // by a separate display controller, and explicit layouts can only be
+    // imported into EGL with the modifiers extension
+    if (_glfw.drm.render_fd > 0 ||
+        !_glfw.drm.egl.EXT_image_dma_buf_import_modifiers)
+    {
+        window->drm.modifier_count = 0;
+    }
+}
+
+// Creates the ring of scanout buffers at the current size of the window
+//
+// The context of the window must be current
+//
+static GLFWbool createFramebuffers(_GLFWwindow* window)
+{
+    int i;
+
+    window->drm.scanout_buffer = 0;
+    window->drm.flip_buffer = -1;
+    window->drm.back_buffer = -1;
+    window->drm.next_buffer = 1;
+    window->drm.queue_count = 0;
+
+    for (i = 0;  i < window->drm.buffer_count;  i++)
+    {
+        window->drm.framebuffers[i].render_fence = -1;
+        window->drm.framebuffers[i].release_fence = -1;
+    }
+
+    for (i = 0;  i < window->drm.buffer_count;  i++)
+    {
+        if (!CreateFramebuffer(window, window->drm.width, window->drm.height,
+                               &window->drm.framebuffers[i]))
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "DRM: Failed to create %ix%i scanout buffers",
+                            window->drm.width, window->drm.height);
+            return GLFW_FALSE;
+        }
+
+        window->drm.framebuffers[i].state = _GLFW_DRM_BUFFER_FREE;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Destroys the ring of scanout buffers of the window
+//
+static void destroyFramebuffers(_GLFWwindow* window)
+{
+    int i;
+    _GLFWwindow* previous = pushContext(window);
 
-  const EGLint khr_image_attrs[] = {EGL_DMA_BUF_PLANE0_FD_EXT,
-                                    framebuffer->fd,
-                                    EGL_WIDTH,
-                                    width,
-                                    EGL_HEIGHT,
-                                    height,
-                                    EGL_LINUX_DRM_FOURCC_EXT,
-                                    GBM_FORMAT_XRGB8888,
-                                    EGL_DMA_BUF_PLANE0_PITCH_EXT,
-                                    stride,
-                                    EGL_DMA_BUF_PLANE0_OFFSET_EXT,
-                                    offset,
-                                    EGL_NONE};
+    for (i = 0;  i < window->drm.buffer_count;  i++)
+        destroyFramebuffer(window->drm.framebuffers + i);
 
-  framebuffer->image =
-      eglCreateImageKHR(_glfw.egl.display, EGL_NO_CONTEXT, EGL_LINUX_DMA_BUF_EXT,
-                          NULL /* no client buffer */, khr_image_attrs);
-  if (framebuffer->image == EGL_NO_IMAGE_KHR) {
-    fprintf(stderr, "failed to make image from buffer object: %s\n",
-            eglGetError());
-    return GLFW_FALSE;
-  }
+    popContext(window, previous);
+}
 
-  glGenTextures(1, &framebuffer->gl_tex);
-  glBindTexture(GL_TEXTURE_2D, framebuffer->gl_tex);
-  glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, framebuffer->image);
-  glBindTexture(GL_TEXTURE_2D, 0);
+// Makes the first buffer of a new ring the one on screen and the next one the
+// render target
+//
+static GLFWbool startScanout(_GLFWwindow* window)
+{
+    _GLFWmonitor* monitor = window->drm.output;
+    Framebuffer* fb = &window->drm.framebuffers[window->drm.scanout_buffer];
 
-  glGenFramebuffers(1, &framebuffer->gl_fb);
-  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer->gl_fb);
-  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
-                         framebuffer->gl_tex, 0);
+    if (window->drm.headless)
+    {
+        // There is no frame for readers until the first buffer swap
+        window->drm.scanout_buffer = -1;
+        window->drm.next_buffer = 0;
+        acquireBackBuffer(window);
+        return GLFW_TRUE;
+    }
 
-  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-    fprintf(stderr,
-            "failed framebuffer check for created target buffer: %x\n",
-            glCheckFramebufferStatus(GL_FRAMEBUFFER));
-    glDeleteFramebuffers(1, &framebuffer->gl_fb);
-    glDeleteTextures(1, &framebuffer->gl_tex);
-    return GLFW_FALSE;
-  }
+    // Need to do the first mode setting before page flip.  While the VT is
+    // away this happens once it is switched back to
+    if (_glfw.drm.active)
+    {
+        if (!ModeSetCrtc(monitor, fb->fb_id))
+            return GLFW_FALSE;
 
-  return GLFW_TRUE;
-}
+        setAdaptiveSync(monitor, window->drm.adaptive_sync);
+    }
 
-GLFWbool ModeSetCrtc(uint32_t fb_id) {
-  /* perform actual modesetting on each found connector+CRTC */
-  _glfw.drm.saved_crtc = drmModeGetCrtc(_glfw.drm.fd, _glfw.drm.crtc);
-  int ret = drmModeSetCrtc(_glfw.drm.fd, _glfw.drm.crtc, fb_id, 0, 0,
-                           &_glfw.drm.conn, 1, &_glfw.drm.mode);
-  if (ret) {
-    fprintf(stderr, "cannot set CRTC for connector %u (%d): %m\n",
-            _glfw.drm.conn, errno);
-    return GLFW_FALSE;
-  }
-  return GLFW_TRUE;
+    fb->state = _GLFW_DRM_BUFFER_SCANOUT;
+    acquireBackBuffer(window);
+    return GLFW_TRUE;
 }
 
 
@@ -359,119 +2040,141 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
                               const _GLFWctxconfig* ctxconfig,
                               const _GLFWfbconfig* fbconfig)
 {
+    int i;
+    _GLFWmonitor* monitor = window->monitor;
 
-  char *card = "/dev/dri/card0";
-  fprintf(stdout, "using card: '%s'\n", card);
-  if (!DeviceOpen(card))
-    return GLFW_FALSE;
+    if (wndconfig->drm.bufferCount < 2 ||
+        wndconfig->drm.bufferCount > _GLFW_DRM_MAX_BUFFERS)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "DRM: Invalid scanout buffer count %i",
+                        wndconfig->drm.bufferCount);
+        return GLFW_FALSE;
+    }
 
-  if (!GetConnector())
-    return GLFW_FALSE;
+    if (ctxconfig->client == GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_API_UNAVAILABLE,
+                        "DRM: Windows without a context are not supported");
+        return GLFW_FALSE;
+    }
 
-    dlopen("libglapi.so.0", RTLD_LAZY | RTLD_GLOBAL);
-    _glfw.drm.display = gbm_create_device(_glfw.drm.fd);
-    if (!_glfw.drm.display) {
-      fprintf(stderr, "cannot create gbm device.\n");
-      return GLFW_FALSE;
+    // Headless windows are never scanned out and need no monitor
+    if (wndconfig->drm.headless)
+        monitor = NULL;
+    // Each monitor scans out a single window, so windowed mode windows take
+    // the first monitor that is still free
+    else if (!monitor)
+    {
+        for (i = 0;  i < _glfw.monitorCount;  i++)
+        {
+            if (!_glfw.monitors[i]->drm.window)
+            {
+                monitor = _glfw.monitors[i];
+                break;
+            }
+        }
     }
-    printf("device created\n");
 
-    //EGLDisplay egl_display = weston_platform_get_egl_display(EGL_PLATFORM_GBM_KHR, _glfw.drm.display, NULL);
+    if (!wndconfig->drm.headless && (!monitor || monitor->drm.window))
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: No free monitor to scan out the window on");
+        return GLFW_FALSE;
+    }
 
-//printf("display created %p\n", egl_display);
-/*    EGLint major, minor = 0;
-    if (!eglInitialize(egl_display, &major, &minor)) {
-      fprintf(stderr, "failed to initialize\n");
-      return GLFW_FALSE;
+    if (!_glfw.egl.handle)
+    {
+        if (!_glfwInitEGL())
+            return GLFW_FALSE;
     }
 
-    printf("Using display %p with EGL version %d.%d\n", egl_.display, major,
-           minor);
+    if (!_glfwCreateContextEGL(window, ctxconfig, fbconfig))
+        return GLFW_FALSE;
 
-    printf("EGL Version \"%s\"\n", eglQueryString(egl_display, EGL_VERSION));
-    printf("EGL Vendor \"%s\"\n", eglQueryString(egl_display, EGL_VENDOR));
+    loadFenceFunctions();
 
-    if (!eglBindAPI(EGL_OPENGL_ES_API)) {
-      fprintf(stderr, "failed to bind api EGL_OPENGL_ES_API\n");
-      return GLFW_FALSE;
-    }*/
+    window->drm.output = monitor;
+    window->drm.headless = wndconfig->drm.headless;
+    window->drm.adaptive_sync = wndconfig->drm.adaptiveSync;
+    window->drm.swap_interval = 1;
+    window->context.swapInterval = swapIntervalDRM;
+
+    if (monitor)
+    {
+        monitor->drm.window = window;
 
-    printf("%d %d\n", _glfw.drm.mode.hdisplay, _glfw.drm.mode.vdisplay);
+        // Full screen windows switch the monitor to the closest mode to their
+        // size, while windowed mode windows cover the monitor in its
+        // preferred mode
+        if (window->monitor)
+            _glfwSetVideoModeDRM(monitor, &window->videoMode);
 
-    if (ctxconfig->client != GLFW_NO_API)
+        window->drm.width = monitor->drm.mode.hdisplay;
+        window->drm.height = monitor->drm.mode.vdisplay;
+    }
+    else
     {
-      if (!_glfwInitEGL())
-          return GLFW_FALSE;
+        window->drm.width = wndconfig->width;
+        window->drm.height = wndconfig->height;
     }
 
-  //     window->drm.window =
-  //   gbm_surface_create (_glfw.drm.display,
-  //                       _glfw.drm.mode.hdisplay,
-  //                       _glfw.drm.mode.vdisplay,
-  //                       GBM_BO_FORMAT_XRGB8888,
-  //                       GBM_BO_USE_SCANOUT |
-  //                       GBM_BO_USE_RENDERING);
+    chooseBufferFormat(window, fbconfig->redBits > 8 ||
+                               fbconfig->greenBits > 8 ||
+                               fbconfig->blueBits > 8);
 
-  // if (!window->drm.window)
-  //   {
-  //     fprintf(stderr,"Failed to allocate surface\n");
-  //     return GLFW_FALSE;
-  //   }
+    window->drm.buffer_count = wndconfig->drm.bufferCount;
 
+    window->context.makeCurrent(window);
 
-    if (ctxconfig->client != GLFW_NO_API)
-    {
-      if (!_glfwCreateContextEGL(window, ctxconfig, fbconfig))
-          return GLFW_FALSE;
-    }
+    if (!createFramebuffers(window))
+        return GLFW_FALSE;
 
-    window->context.makeCurrent(window);
+    if (!startScanout(window))
+        return GLFW_FALSE;
 
-    //DRMModesetter::Size display_size = drm_->GetDisplaySize();
-    for (int i = 0; i < 2; i++)
+    if (window->drm.headless)
     {
-      if (!CreateFramebuffer(_glfw.drm.mode.hdisplay, _glfw.drm.mode.vdisplay, &_glfw.drm.framebuffers[i])) {
-        fprintf(stderr, "cannot create framebuffer.\n");
-        return GLFW_FALSE;
-      }
+        window->context.swapBuffers = swapBuffersHeadless;
+        return GLFW_TRUE;
     }
 
-    _glfw.drm.front_buffer = 0;
+    window->context.swapBuffers = swapBuffersDRM;
 
-    // Need to do the first mode setting before page flip.
-    if (!ModeSetCrtc(_glfw.drm.framebuffers[_glfw.drm.front_buffer].fb_id))
-      return GLFW_FALSE;
+    // Windows without a cursor of their own show the arrow
+    if (!_glfw.drm.default_cursor.bo && _glfw.drm.cursor_device)
+        createStandardCursor(&_glfw.drm.default_cursor, GLFW_ARROW_CURSOR);
 
-    window->context.swapBuffers = swapBuffersDRM;
+    updateCursor();
 
-  return GLFW_TRUE;
+    return GLFW_TRUE;
+}
 
-  /*
-    if (!createNativeWindow(window, wndconfig))
-        return GLFW_FALSE;
+void _glfwPlatformDestroyWindow(_GLFWwindow* window)
+{
+    _GLFWmonitor* monitor = window->drm.output;
 
-    if (ctxconfig->client != GLFW_NO_API)
+    if (monitor)
     {
-        if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API ||
-            ctxconfig->source == GLFW_OSMESA_CONTEXT_API)
-        {
-            if (!_glfwInitOSMesa())
-                return GLFW_FALSE;
-            if (!_glfwCreateContextOSMesa(window, ctxconfig, fbconfig))
-                return GLFW_FALSE;
-        }
+        // The kernel may still be about to scan out the buffer being flipped to
+        waitForPageFlip(window);
+
+        // The display belongs to another session while the VT is away, so the
+        // monitor is handed back once it is switched back to
+        if (_glfw.drm.active)
+            releaseMonitor(monitor);
         else
-        {
-            _glfwInputError(GLFW_API_UNAVAILABLE, "Null: EGL not available");
-            return GLFW_FALSE;
-        }
+            monitor->drm.release_pending = GLFW_TRUE;
+
+        _glfwRestoreVideoModeDRM(monitor);
+        monitor->drm.window = NULL;
     }
 
-    return GLFW_TRUE;*/
-}
+    if (window->context.client != GLFW_NO_API)
+        destroyFramebuffers(window);
+
+    free(window->drm.modifiers);
 
-void _glfwPlatformDestroyWindow(_GLFWwindow* window)
-{
     if (window->context.destroy)
         window->context.destroy(window);
 }
@@ -491,10 +2194,173 @@ void _glfwPlatformSetWindowMonitor(_GLFWwindow* window,
                                    int width, int height,
                                    int refreshRate)
 {
+    _GLFWwindow* previous;
+    GLFWbool created;
+    GLFWvidmode previousMode;
+    _GLFWmonitor* output = window->drm.output;
+    _GLFWmonitor* previousOutput = window->drm.output;
+    _GLFWmonitor* previousMonitor = window->monitor;
+    const int previousWidth = window->drm.width;
+    const int previousHeight = window->drm.height;
+    const GLFWbool deepColor = window->drm.format == GBM_FORMAT_XRGB2101010;
+
+    if (previousOutput)
+        _glfwPlatformGetVideoMode(previousOutput, &previousMode);
+
+    if (window->drm.headless)
+    {
+        // Headless windows are never scanned out, so only their size changes
+        if (window->drm.width == width && window->drm.height == height)
+            return;
+    }
+    else
+    {
+        // Windowed mode windows stay on the monitor they are on
+        if (monitor)
+        {
+            if (monitor->drm.window && monitor->drm.window != window)
+            {
+                _glfwInputError(GLFW_PLATFORM_ERROR,
+                                "DRM: The monitor is already scanning out another window");
+                return;
+            }
+
+            output = monitor;
+        }
+
+        // Every buffer swapped so far is shown before the old ring goes away
+        waitForPageFlips(window);
+
+        if (output != window->drm.output)
+        {
+            _GLFWmonitor* old = window->drm.output;
+
+            if (_glfw.drm.active)
+                releaseMonitor(old);
+            else
+                old->drm.release_pending = GLFW_TRUE;
+
+            _glfwRestoreVideoModeDRM(old);
+            old->drm.window = NULL;
+
+            output->drm.window = window;
+            window->drm.output = output;
+
+            // Vblank counters are per CRTC, so frame timing starts over
+            window->drm.flip_count = 0;
+            window->drm.target_valid = GLFW_FALSE;
+        }
+
+        if (monitor)
+            _glfwSetVideoModeDRM(output, &window->videoMode);
+        else
+            _glfwRestoreVideoModeDRM(output);
+
+        width = output->drm.mode.hdisplay;
+        height = output->drm.mode.vdisplay;
+
+        // Nothing needs to be reallocated if the monitor kept its mode
+        if (output == window->drm.output &&
+            window->drm.width == width && window->drm.height == height &&
+            window->monitor == monitor)
+        {
+            return;
+        }
+    }
+
+    // Headless windows have no monitor to be full screen on
+    if (window->drm.headless)
+        _glfwInputWindowMonitor(window, NULL);
+    else
+        _glfwInputWindowMonitor(window, monitor);
+
+    // The new mode gets a fresh ring of buffers of its size, as the old ones
+    // cannot be scanned out at a different resolution
+    destroyFramebuffers(window);
+
+    window->drm.width = width;
+    window->drm.height = height;
+    window->drm.flip_client = GLFW_FALSE;
+    window->drm.flip_overlay = GLFW_FALSE;
+    window->drm.flip_waiting = GLFW_FALSE;
+
+    if (!window->drm.headless)
+        chooseBufferFormat(window, deepColor);
+
+    previous = pushContext(window);
+
+    created = createFramebuffers(window) && startScanout(window);
+    if (!created)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: Failed to switch the window to a %ix%i mode",
+                        width, height);
+
+        // The window goes back to where it was, with a ring of the size that
+        // worked before
+        destroyFramebuffers(window);
+
+        if (output != previousOutput)
+        {
+            if (_glfw.drm.active)
+                releaseMonitor(output);
+            else
+                output->drm.release_pending = GLFW_TRUE;
+
+            _glfwRestoreVideoModeDRM(output);
+            output->drm.window = NULL;
+
+            previousOutput->drm.window = window;
+            window->drm.output = previousOutput;
+        }
+
+        if (previousOutput)
+        {
+            if (previousMonitor)
+                _glfwSetVideoModeDRM(previousOutput, &previousMode);
+            else
+                _glfwRestoreVideoModeDRM(previousOutput);
+        }
+
+        _glfwInputWindowMonitor(window, previousMonitor);
+
+        window->drm.width = previousWidth;
+        window->drm.height = previousHeight;
+
+        if (!window->drm.headless)
+            chooseBufferFormat(window, deepColor);
+
+        if (createFramebuffers(window))
+            startScanout(window);
+    }
+
+    popContext(window, previous);
+
+    if (!window->drm.headless)
+        updateCursor();
+
+    // The window keeps its previous size if the new mode could not be used
+    if (!created)
+        return;
+
+    _glfwInputFramebufferSize(window, width, height);
+    _glfwInputWindowSize(window, width, height);
+
+    if (!window->drm.headless)
+        _glfwInputWindowPos(window, output->drm.xpos, output->drm.ypos);
 }
 
 void _glfwPlatformGetWindowPos(_GLFWwindow* window, int* xpos, int* ypos)
 {
+    if (window->drm.output)
+        _glfwPlatformGetMonitorPos(window->drm.output, xpos, ypos);
+    else
+    {
+        if (xpos)
+            *xpos = 0;
+        if (ypos)
+            *ypos = 0;
+    }
 }
 
 void _glfwPlatformSetWindowPos(_GLFWwindow* window, int xpos, int ypos)
@@ -504,9 +2370,9 @@ void _glfwPlatformSetWindowPos(_GLFWwindow* window, int xpos, int ypos)
 void _glfwPlatformGetWindowSize(_GLFWwindow* window, int* width, int* height)
 {
     if (width)
-        *width = 1920;//window->null.width;
+        *width = window->drm.width;
     if (height)
-        *height = 1080;//window->null.height;
+        *height = window->drm.height;
 }
 
 void _glfwPlatformSetWindowSize(_GLFWwindow* window, int width, int height)
@@ -525,10 +2391,7 @@ void _glfwPlatformSetWindowAspectRatio(_GLFWwindow* window, int n, int d)
 
 void _glfwPlatformGetFramebufferSize(_GLFWwindow* window, int* width, int* height)
 {
-    if (width)
-        *width = 1920;//window->null.width;
-    if (height)
-        *height = 1080;//window->null.height;
+    _glfwPlatformGetWindowSize(window, width, height);
 }
 
 void _glfwPlatformGetWindowFrameSize(_GLFWwindow* window,
@@ -617,12 +2480,12 @@ void _glfwPlatformFocusWindow(_GLFWwindow* window)
 
 int _glfwPlatformWindowFocused(_GLFWwindow* window)
 {
-    return GLFW_TRUE;
+    return _glfw.drm.active;
 }
 
 int _glfwPlatformWindowIconified(_GLFWwindow* window)
 {
-    return GLFW_FALSE;
+    return window->drm.output && !_glfw.drm.active;
 }
 
 int _glfwPlatformWindowVisible(_GLFWwindow* window)
@@ -632,53 +2495,86 @@ int _glfwPlatformWindowVisible(_GLFWwindow* window)
 
 void _glfwPlatformPollEvents(void)
 {
+    handleVTSwitch();
 
+    // Completed flips are processed without waiting for any in flight
+    if (_glfw.drm.fd > 0)
+        dispatchDRMEvents(0);
+
+    handleInputEvents();
+    handleKeyRepeat();
+    _glfwDispatchEventSourcesPOSIX();
 }
 
 void _glfwPlatformWaitEvents(void)
 {
-  _glfwPlatformPollEvents();
+    waitForEvent(NULL);
+    _glfwPlatformPollEvents();
 }
 
 void _glfwPlatformWaitEventsTimeout(double timeout)
 {
-  _glfwPlatformPollEvents();
+    waitForEvent(&timeout);
+    _glfwPlatformPollEvents();
 }
 
 void _glfwPlatformPostEmptyEvent(void)
 {
+    const uint64_t value = 1;
+
+    while (write(_glfw.drm.empty_event_fd, &value, sizeof(value)) == -1 &&
+           errno == EINTR)
+        ;
 }
 
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
 {
+    int xoffset = 0, yoffset = 0;
+
+    if (window->drm.output)
+        _glfwPlatformGetMonitorPos(window->drm.output, &xoffset, &yoffset);
+
+    if (xpos)
+        *xpos = _glfw.drm.cursor_x - xoffset;
+    if (ypos)
+        *ypos = _glfw.drm.cursor_y - yoffset;
 }
 
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, double x, double y)
 {
+    // Headless windows do not own the pointer
+    if (!window->drm.output)
+        return;
+
+    setCursorPosition(window->drm.output->drm.xpos + x,
+                      window->drm.output->drm.ypos + y);
 }
 
 void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
 {
+    updateCursor();
 }
 
 int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
                               const GLFWimage* image,
                               int xhot, int yhot)
 {
-    return GLFW_TRUE;
+    return createCursor(&cursor->drm, image, xhot, yhot);
 }
 
 int _glfwPlatformCreateStandardCursor(_GLFWcursor* cursor, int shape)
 {
-    return GLFW_TRUE;
+    return createStandardCursor(&cursor->drm, shape);
 }
 
 void _glfwPlatformDestroyCursor(_GLFWcursor* cursor)
 {
+    destroyCursor(&cursor->drm);
 }
 
 void _glfwPlatformSetCursor(_GLFWwindow* window, _GLFWcursor* cursor)
 {
+    updateCursor();
 }
 
 void _glfwPlatformSetClipboardString(const char* string)
@@ -690,14 +2586,46 @@ const char* _glfwPlatformGetClipboardString(void)
     return NULL;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window,
+                                         GLFWclipboardfun cbfun,
+                                         double timeout)
+{
+    cbfun((GLFWwindow*) window, NULL);
+}
+
 const char* _glfwPlatformGetScancodeName(int scancode)
 {
-    return "";
+    const xkb_keysym_t* keysyms;
+    const xkb_keycode_t keycode = scancode + 8;
+    const xkb_layout_index_t layout =
+        xkb_state_key_get_layout(_glfw.drm.xkb.state, keycode);
+
+    if (layout == XKB_LAYOUT_INVALID)
+        return NULL;
+
+    if (xkb_keymap_key_get_syms_by_level(_glfw.drm.xkb.keymap, keycode,
+                                         layout, 0, &keysyms) != 1)
+    {
+        return NULL;
+    }
+
+    // Only keys producing printable text have names
+    const uint32_t codepoint = xkb_keysym_to_utf32(keysyms[0]);
+    if (codepoint < 0x20 || codepoint == 0x7f)
+        return NULL;
+
+    if (xkb_keysym_to_utf8(keysyms[0], _glfw.drm.keyName,
+                           sizeof(_glfw.drm.keyName)) <= 0)
+    {
+        return NULL;
+    }
+
+    return _glfw.drm.keyName;
 }
 
 int _glfwPlatformGetKeyScancode(int key)
 {
-    return -1;
+    return _glfw.drm.scancodes[key];
 }
 
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
@@ -720,3 +2648,238 @@ VkResult _glfwPlatformCreateWindowSurface(VkInstance instance,
     return VK_ERROR_INITIALIZATION_FAILED;
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+//////                        GLFW native API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWAPI int glfwGetDRMDevice(void)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(-1);
+    return _glfw.drm.fd;
+}
+
+GLFWAPI uint32_t glfwImportDRMBuffer(int width, int height,
+                                     uint32_t format, uint64_t modifier,
+                                     int count, const int* fds,
+                                     const uint32_t* pitches,
+                                     const uint32_t* offsets)
+{
+    int i, ret = 0;
+    uint32_t handles[4] = { 0 }, strides[4] = { 0 }, starts[4] = { 0 };
+    uint64_t modifiers[4] = { 0 };
+    uint32_t fb_id = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (count < 1 || count > 4)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "DRM: Invalid dma-buf plane count %i", count);
+        return 0;
+    }
+
+    for (i = 0;  i < count;  i++)
+    {
+        if (drmPrimeFDToHandle(_glfw.drm.fd, fds[i], &handles[i]) != 0)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "DRM: Failed to import dma-buf: %s",
+                            strerror(errno));
+            ret = -1;
+            break;
+        }
+
+        strides[i] = pitches[i];
+        starts[i] = offsets[i];
+        modifiers[i] = modifier;
+    }
+
+    if (ret == 0)
+    {
+        if (modifier != DRM_FORMAT_MOD_INVALID)
+        {
+            ret = drmModeAddFB2WithModifiers(_glfw.drm.fd, width, height, format,
+                                             handles, strides, starts, modifiers,
+                                             &fb_id, DRM_MODE_FB_MODIFIERS);
+        }
+        else
+        {
+            ret = drmModeAddFB2(_glfw.drm.fd, width, height, format,
+                                handles, strides, starts, &fb_id, 0);
+        }
+
+        if (ret != 0)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "DRM: Failed to create framebuffer for dma-buf: %s",
+                            strerror(errno));
+            fb_id = 0;
+        }
+    }
+
+    // The framebuffer holds its own references to the buffers, and planes
+    // sharing a dma-buf share a handle that must only be closed once
+    for (i = 0;  i < count;  i++)
+    {
+        int j;
+
+        if (!handles[i])
+            continue;
+
+        for (j = 0;  j < i;  j++)
+        {
+            if (handles[j] == handles[i])
+                break;
+        }
+
+        if (j == i)
+        {
+            struct drm_gem_close args = { handles[i], 0 };
+            drmIoctl(_glfw.drm.fd, DRM_IOCTL_GEM_CLOSE, &args);
+        }
+    }
+
+    return fb_id;
+}
+
+GLFWAPI void glfwDestroyDRMBuffer(uint32_t buffer)
+{
+    _GLFW_REQUIRE_INIT();
+
+    if (buffer)
+        drmModeRmFB(_glfw.drm.fd, buffer);
+}
+
+GLFWAPI int glfwPresentDRMBuffer(GLFWwindow* handle, uint32_t buffer)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (window->drm.headless)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "DRM: Headless windows cannot present buffers");
+        return GLFW_FALSE;
+    }
+
+    // Frames swapped before this call reach the screen first
+    waitForPageFlips(window);
+
+    return pageFlipClient(window, buffer, GLFW_FALSE,
+                          0, 0,
+                          window->drm.output->drm.mode.hdisplay,
+                          window->drm.output->drm.mode.vdisplay);
+}
+
+GLFWAPI int glfwSetDRMOverlayBuffer(GLFWwindow* handle, uint32_t buffer,
+                                    int xpos, int ypos, int width, int height)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!window->drm.output || !window->drm.output->drm.overlay)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "DRM: No overlay plane available for the window");
+        return GLFW_FALSE;
+    }
+
+    waitForPageFlip(window);
+
+    return pageFlipClient(window, buffer, GLFW_TRUE,
+                          xpos, ypos, width, height);
+}
+
+GLFWAPI int glfwGetDRMFrameTiming(GLFWwindow* handle, uint64_t* sequence,
+                                  double* time, uint64_t* missed)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (sequence)
+        *sequence = 0;
+    if (time)
+        *time = 0.0;
+    if (missed)
+        *missed = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!window->drm.flip_count)
+        return GLFW_FALSE;
+
+    if (sequence)
+        *sequence = window->drm.flip_sequence;
+    if (time)
+        *time = window->drm.flip_time;
+    if (missed)
+        *missed = window->drm.missed_frames;
+
+    return GLFW_TRUE;
+}
+
+GLFWAPI int glfwGetDRMFrameBuffer(GLFWwindow* handle, int* fd,
+                                  uint32_t* format, uint32_t* stride)
+{
+    Framebuffer* fb;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (fd)
+        *fd = -1;
+    if (format)
+        *format = 0;
+    if (stride)
+        *stride = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!window->drm.headless)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "DRM: Only headless windows have readable frames");
+        return GLFW_FALSE;
+    }
+
+    if (window->drm.scanout_buffer == -1)
+        return GLFW_FALSE;
+
+    fb = &window->drm.framebuffers[window->drm.scanout_buffer];
+
+    // The frame is only handed out once rendering to it has completed
+    if (fb->render_fence != -1)
+    {
+        struct pollfd pfd = { fb->render_fence, POLLIN, 0 };
+
+        while (poll(&pfd, 1, -1) == -1 && (errno == EINTR || errno == EAGAIN))
+            ;
+
+        close(fb->render_fence);
+        fb->render_fence = -1;
+    }
+
+    // The caller gets its own reference, so closing it cannot affect the ring
+    if (fd)
+    {
+        *fd = fcntl(fb->fd, F_DUPFD_CLOEXEC, 0);
+        if (*fd == -1)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "DRM: Failed to duplicate frame file descriptor: %s",
+                            strerror(errno));
+            return GLFW_FALSE;
+        }
+    }
+
+    if (format)
+        *format = window->drm.format;
+    if (stride)
+        *stride = gbm_bo_get_stride(fb->bo);
+
+    return GLFW_TRUE;
+}
@@ -182,12 +182,19 @@ static void makeContextCurrentGLX(_GLFWwindow* window)
 static void swapBuffersGLX(_GLFWwindow* window)
 {
     glXSwapBuffers(_glfw.x11.display, window->context.glx.window);
+
+    // The swap completes with the next SBC and is due the configured number
+    // of vblanks after the previous frame
+    _glfwQueueSwapX11(window, window->x11.frame.sbc + 1, 0,
+                      window->x11.frame.interval);
 }
 
 static void swapIntervalGLX(int interval)
 {
     _GLFWwindow* window = _glfwPlatformGetTls(&_glfw.contextSlot);
 
+    window->x11.frame.interval = interval;
+
     if (_glfw.glx.EXT_swap_control)
     {
         _glfw.glx.SwapIntervalEXT(_glfw.x11.display,
@@ -416,6 +423,26 @@ GLFWbool _glfwInitGLX(void)
     if (extensionSupportedGLX("GLX_ARB_context_flush_control"))
         _glfw.glx.ARB_context_flush_control = GLFW_TRUE;
 
+    if (extensionSupportedGLX("GLX_OML_sync_control"))
+    {
+        _glfw.glx.GetSyncValuesOML = (PFNGLXGETSYNCVALUESOMLPROC)
+            getProcAddressGLX("glXGetSyncValuesOML");
+        _glfw.glx.GetMscRateOML = (PFNGLXGETMSCRATEOMLPROC)
+            getProcAddressGLX("glXGetMscRateOML");
+        _glfw.glx.SwapBuffersMscOML = (PFNGLXSWAPBUFFERSMSCOMLPROC)
+            getProcAddressGLX("glXSwapBuffersMscOML");
+        _glfw.glx.WaitForSbcOML = (PFNGLXWAITFORSBCOMLPROC)
+            getProcAddressGLX("glXWaitForSbcOML");
+
+        if (_glfw.glx.GetSyncValuesOML &&
+            _glfw.glx.GetMscRateOML &&
+            _glfw.glx.SwapBuffersMscOML &&
+            _glfw.glx.WaitForSbcOML)
+        {
+            _glfw.glx.OML_sync_control = GLFW_TRUE;
+        }
+    }
+
     return GLFW_TRUE;
 }
 
@@ -619,6 +646,9 @@ GLFWbool _glfwCreateContextGLX(_GLFWwindow* window,
         return GLFW_FALSE;
     }
 
+    // GLX drivers swap at every vblank until told otherwise
+    window->x11.frame.interval = 1;
+
     window->context.makeCurrent = makeContextCurrentGLX;
     window->context.swapBuffers = swapBuffersGLX;
     window->context.swapInterval = swapIntervalGLX;
@@ -664,6 +694,28 @@ GLFWbool _glfwChooseVisualGLX(const _GLFWwndconfig* wndconfig,
 }
 
 
+// Returns whether OML_sync_control can be used with the specified window
+//
+static GLFWbool checkSyncControlGLX(_GLFWwindow* window)
+{
+    if (window->context.client == GLFW_NO_API ||
+        window->context.source != GLFW_NATIVE_CONTEXT_API)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT, NULL);
+        return GLFW_FALSE;
+    }
+
+    if (!_glfw.glx.OML_sync_control)
+    {
+        _glfwInputError(GLFW_API_UNAVAILABLE,
+                        "GLX: GLX_OML_sync_control is unavailable");
+        return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                        GLFW native API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -696,3 +748,149 @@ GLFWAPI GLXWindow glfwGetGLXWindow(GLFWwindow* handle)
     return window->context.glx.window;
 }
 
+GLFWAPI int glfwGetGLXSyncValues(GLFWwindow* handle,
+                                 int64_t* ust, int64_t* msc, int64_t* sbc)
+{
+    int64_t values[3];
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (ust)
+        *ust = 0;
+    if (msc)
+        *msc = 0;
+    if (sbc)
+        *sbc = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!checkSyncControlGLX(window))
+        return GLFW_FALSE;
+
+    if (!_glfw.glx.GetSyncValuesOML(_glfw.x11.display,
+                                    window->context.glx.window,
+                                    values + 0, values + 1, values + 2))
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "GLX: Failed to retrieve sync values");
+        return GLFW_FALSE;
+    }
+
+    if (ust)
+        *ust = values[0];
+    if (msc)
+        *msc = values[1];
+    if (sbc)
+        *sbc = values[2];
+
+    return GLFW_TRUE;
+}
+
+GLFWAPI int glfwGetGLXMscRate(GLFWwindow* handle,
+                              int* numerator, int* denominator)
+{
+    int32_t num, denom;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (numerator)
+        *numerator = 0;
+    if (denominator)
+        *denominator = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!checkSyncControlGLX(window))
+        return GLFW_FALSE;
+
+    if (!_glfw.glx.GetMscRateOML(_glfw.x11.display,
+                                 window->context.glx.window,
+                                 &num, &denom))
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "GLX: Failed to retrieve MSC rate");
+        return GLFW_FALSE;
+    }
+
+    if (numerator)
+        *numerator = num;
+    if (denominator)
+        *denominator = denom;
+
+    return GLFW_TRUE;
+}
+
+GLFWAPI int64_t glfwSwapGLXBuffersMsc(GLFWwindow* handle, int64_t target,
+                                      int64_t divisor, int64_t remainder)
+{
+    int64_t sbc;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(target >= 0);
+    assert(divisor >= 0);
+    assert(remainder >= 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(-1);
+
+    if (!checkSyncControlGLX(window))
+        return -1;
+
+    if (divisor && remainder >= divisor)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "GLX: Invalid MSC remainder %lld for divisor %lld",
+                        (long long) remainder, (long long) divisor);
+        return -1;
+    }
+
+    sbc = _glfw.glx.SwapBuffersMscOML(_glfw.x11.display,
+                                      window->context.glx.window,
+                                      target, divisor, remainder);
+    if (sbc == -1)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR, "GLX: Failed to swap buffers");
+        return -1;
+    }
+
+    // Only a plain target is a deadline that frames can be counted as
+    // missing, as a divisor lets the swap wait for a later vblank
+    _glfwQueueSwapX11(window, (uint64_t) sbc,
+                      divisor ? 0 : (uint64_t) target, 0);
+
+    return sbc;
+}
+
+GLFWAPI int glfwWaitGLXSwapComplete(GLFWwindow* handle, int64_t sbc,
+                                    int64_t* ust, int64_t* msc)
+{
+    int64_t values[3];
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(sbc >= 0);
+
+    if (ust)
+        *ust = 0;
+    if (msc)
+        *msc = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!checkSyncControlGLX(window))
+        return GLFW_FALSE;
+
+    if (!_glfw.glx.WaitForSbcOML(_glfw.x11.display,
+                                 window->context.glx.window,
+                                 sbc, values + 0, values + 1, values + 2))
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "GLX: Failed to wait for buffer swap");
+        return GLFW_FALSE;
+    }
+
+    if (ust)
+        *ust = values[0];
+    if (msc)
+        *msc = values[1];
+
+    return GLFW_TRUE;
+}
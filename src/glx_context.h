@@ -91,6 +91,10 @@ typedef void (*PFNGLXDESTROYWINDOWPROC)(Display*,GLXWindow);
 typedef int (*PFNGLXSWAPINTERVALMESAPROC)(int);
 typedef int (*PFNGLXSWAPINTERVALSGIPROC)(int);
 typedef GLXContext (*PFNGLXCREATECONTEXTATTRIBSARBPROC)(Display*,GLXFBConfig,GLXContext,Bool,const int*);
+typedef Bool (*PFNGLXGETSYNCVALUESOMLPROC)(Display*,GLXDrawable,int64_t*,int64_t*,int64_t*);
+typedef Bool (*PFNGLXGETMSCRATEOMLPROC)(Display*,GLXDrawable,int32_t*,int32_t*);
+typedef int64_t (*PFNGLXSWAPBUFFERSMSCOMLPROC)(Display*,GLXDrawable,int64_t,int64_t,int64_t);
+typedef Bool (*PFNGLXWAITFORSBCOMLPROC)(Display*,GLXDrawable,int64_t,int64_t*,int64_t*,int64_t*);
 
 // libGL.so function pointer typedefs
 #define glXGetFBConfigs _glfw.glx.GetFBConfigs
@@ -153,6 +157,10 @@ typedef struct _GLFWlibraryGLX
     PFNGLXSWAPINTERVALEXTPROC           SwapIntervalEXT;
     PFNGLXSWAPINTERVALMESAPROC          SwapIntervalMESA;
     PFNGLXCREATECONTEXTATTRIBSARBPROC   CreateContextAttribsARB;
+    PFNGLXGETSYNCVALUESOMLPROC          GetSyncValuesOML;
+    PFNGLXGETMSCRATEOMLPROC             GetMscRateOML;
+    PFNGLXSWAPBUFFERSMSCOMLPROC         SwapBuffersMscOML;
+    PFNGLXWAITFORSBCOMLPROC             WaitForSbcOML;
     GLFWbool        SGI_swap_control;
     GLFWbool        EXT_swap_control;
     GLFWbool        MESA_swap_control;
@@ -165,6 +173,7 @@ typedef struct _GLFWlibraryGLX
     GLFWbool        EXT_create_context_es2_profile;
     GLFWbool        ARB_create_context_no_error;
     GLFWbool        ARB_context_flush_control;
+    GLFWbool        OML_sync_control;
 
 } _GLFWlibraryGLX;
 
@@ -54,6 +54,10 @@ static _GLFWinitconfig _glfwInitHints =
     {
         GLFW_TRUE,  // macOS menu bar
         GLFW_TRUE   // macOS bundle chdir
+    },
+    {
+        GLFW_DONT_CARE, // DRM scanout device
+        GLFW_DONT_CARE  // DRM render device
     }
 };
 
@@ -269,6 +273,12 @@ GLFWAPI void glfwInitHint(int hint, int value)
         case GLFW_COCOA_MENUBAR:
             _glfwInitHints.ns.menubar = value;
             return;
+        case GLFW_DRM_DEVICE:
+            _glfwInitHints.drm.device = value;
+            return;
+        case GLFW_DRM_RENDER_DEVICE:
+            _glfwInitHints.drm.renderDevice = value;
+            return;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM,
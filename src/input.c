@@ -251,6 +251,30 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
 }
 
 
+// Appends a cursor position dropped by event coalescing to the history
+//
+static void pushCursorHistory(_GLFWwindow* window, double xpos, double ypos)
+{
+    if (window->historyCount == window->historySize)
+    {
+        const int size = window->historySize ? window->historySize * 2 : 64;
+        double* history = realloc(window->history, size * 2 * sizeof(double));
+        if (!history)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return;
+        }
+
+        window->history = history;
+        window->historySize = size;
+    }
+
+    window->history[window->historyCount * 2 + 0] = xpos;
+    window->history[window->historyCount * 2 + 1] = ypos;
+    window->historyCount++;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -259,6 +283,8 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
 //
 void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int mods)
 {
+    _glfwFlushCoalescedEvents(window);
+
     if (key >= 0 && key <= GLFW_KEY_LAST)
     {
         GLFWbool repeated = GLFW_FALSE;
@@ -293,6 +319,8 @@ void _glfwInputChar(_GLFWwindow* window, unsigned int codepoint, int mods, GLFWb
     if (codepoint < 32 || (codepoint > 126 && codepoint < 160))
         return;
 
+    _glfwFlushCoalescedEvents(window);
+
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
@@ -310,6 +338,23 @@ void _glfwInputChar(_GLFWwindow* window, unsigned int codepoint, int mods, GLFWb
 //
 void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset)
 {
+    if (window->coalesceEvents)
+    {
+        if (_glfwCoalesceEvent(window, &window->pending.scroll,
+                               &window->pending.scrollSerial))
+        {
+            window->pending.scrollX += xoffset;
+            window->pending.scrollY += yoffset;
+        }
+        else
+        {
+            window->pending.scrollX = xoffset;
+            window->pending.scrollY = yoffset;
+        }
+
+        return;
+    }
+
     if (window->callbacks.scroll)
         window->callbacks.scroll((GLFWwindow*) window, xoffset, yoffset);
 }
@@ -321,6 +366,8 @@ void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
     if (button < 0 || button > GLFW_MOUSE_BUTTON_LAST)
         return;
 
+    _glfwFlushCoalescedEvents(window);
+
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
@@ -344,6 +391,28 @@ void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos)
     window->virtualCursorPosX = xpos;
     window->virtualCursorPosY = ypos;
 
+    if (window->coalesceEvents)
+    {
+        if (_glfwCoalesceEvent(window, &window->pending.cursorPos,
+                               &window->pending.cursorPosSerial))
+        {
+            if (window->cursorHistory)
+            {
+                pushCursorHistory(window,
+                                  window->pending.cursorPosX,
+                                  window->pending.cursorPosY);
+            }
+        }
+        else
+            window->historyCount = 0;
+
+        window->pending.cursorPosX = xpos;
+        window->pending.cursorPosY = ypos;
+        return;
+    }
+
+    window->historyCount = 0;
+
     if (window->callbacks.cursorPos)
         window->callbacks.cursorPos((GLFWwindow*) window, xpos, ypos);
 }
@@ -352,6 +421,8 @@ void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos)
 //
 void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered)
 {
+    _glfwFlushCoalescedEvents(window);
+
     if (window->callbacks.cursorEnter)
         window->callbacks.cursorEnter((GLFWwindow*) window, entered);
 }
@@ -360,6 +431,8 @@ void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered)
 //
 void _glfwInputDrop(_GLFWwindow* window, int count, const char** paths)
 {
+    _glfwFlushCoalescedEvents(window);
+
     if (window->callbacks.drop)
         window->callbacks.drop((GLFWwindow*) window, count, paths);
 }
@@ -407,6 +480,117 @@ void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value)
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
 
+// Holds an event of the kind with the specified pending flag and serial,
+// returning whether it is merged into one of that kind already pending
+//
+// A pending event is only merged into if no event of another kind arrived
+// after it, as the merged event would otherwise be delivered ahead of those.
+// Otherwise the pending events are delivered up to and including it and the
+// new event is held on its own
+//
+GLFWbool _glfwCoalesceEvent(_GLFWwindow* window,
+                            GLFWbool* pending, unsigned int* serial)
+{
+    while (*pending && *serial != window->pending.serial)
+        _glfwFlushCoalescedEvent(window);
+
+    if (*pending)
+        return GLFW_TRUE;
+
+    *pending = GLFW_TRUE;
+    *serial = ++window->pending.serial;
+    return GLFW_FALSE;
+}
+
+// Delivers the earliest arrived event collapsed by event coalescing, if any
+//
+// Returns whether an event was pending, in which case a callback may have run
+// and the window may no longer exist
+//
+GLFWbool _glfwFlushCoalescedEvent(_GLFWwindow* window)
+{
+    int i, oldest = -1;
+    unsigned int age = 0;
+    const GLFWbool pending[] =
+    {
+        window->pending.size,
+        window->pending.fbsize,
+        window->pending.cursorPos,
+        window->pending.scroll
+    };
+    const unsigned int serials[] =
+    {
+        window->pending.sizeSerial,
+        window->pending.fbsizeSerial,
+        window->pending.cursorPosSerial,
+        window->pending.scrollSerial
+    };
+
+    // Serials are compared by their distance to the latest one, which stays
+    // correct when the counter wraps around
+    for (i = 0;  i < 4;  i++)
+    {
+        if (pending[i] && (oldest == -1 || window->pending.serial - serials[i] > age))
+        {
+            oldest = i;
+            age = window->pending.serial - serials[i];
+        }
+    }
+
+    switch (oldest)
+    {
+        case 0:
+            window->pending.size = GLFW_FALSE;
+            if (window->callbacks.size)
+            {
+                window->callbacks.size((GLFWwindow*) window,
+                                       window->pending.width,
+                                       window->pending.height);
+            }
+            return GLFW_TRUE;
+
+        case 1:
+            window->pending.fbsize = GLFW_FALSE;
+            if (window->callbacks.fbsize)
+            {
+                window->callbacks.fbsize((GLFWwindow*) window,
+                                         window->pending.fbwidth,
+                                         window->pending.fbheight);
+            }
+            return GLFW_TRUE;
+
+        case 2:
+            window->pending.cursorPos = GLFW_FALSE;
+            if (window->callbacks.cursorPos)
+            {
+                window->callbacks.cursorPos((GLFWwindow*) window,
+                                            window->pending.cursorPosX,
+                                            window->pending.cursorPosY);
+            }
+            return GLFW_TRUE;
+
+        case 3:
+            window->pending.scroll = GLFW_FALSE;
+            if (window->callbacks.scroll)
+            {
+                window->callbacks.scroll((GLFWwindow*) window,
+                                         window->pending.scrollX,
+                                         window->pending.scrollY);
+            }
+            return GLFW_TRUE;
+    }
+
+    return GLFW_FALSE;
+}
+
+// Delivers the events collapsed by event coalescing
+//
+void _glfwFlushCoalescedEvents(_GLFWwindow* window)
+{
+    while (_glfwFlushCoalescedEvent(window))
+        ;
+}
+
 // Returns an available joystick object with arrays and name allocated
 //
 _GLFWjoystick* _glfwAllocJoystick(const char* name,
@@ -476,6 +660,10 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* handle, int mode)
             return window->stickyMouseButtons;
         case GLFW_LOCK_KEY_MODS:
             return window->lockKeyMods;
+        case GLFW_COALESCE_EVENTS:
+            return window->coalesceEvents;
+        case GLFW_CURSOR_HISTORY:
+            return window->cursorHistory;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid input mode 0x%08X", mode);
@@ -555,6 +743,24 @@ GLFWAPI void glfwSetInputMode(GLFWwindow* handle, int mode, int value)
     }
     else if (mode == GLFW_LOCK_KEY_MODS)
         window->lockKeyMods = value ? GLFW_TRUE : GLFW_FALSE;
+    else if (mode == GLFW_COALESCE_EVENTS)
+    {
+        value = value ? GLFW_TRUE : GLFW_FALSE;
+        if (window->coalesceEvents == value)
+            return;
+
+        // Deliver any collapsed events before they would be delayed further
+        if (!value)
+            _glfwFlushCoalescedEvents(window);
+
+        window->coalesceEvents = value;
+    }
+    else if (mode == GLFW_CURSOR_HISTORY)
+    {
+        window->cursorHistory = value ? GLFW_TRUE : GLFW_FALSE;
+        if (!window->cursorHistory)
+            window->historyCount = 0;
+    }
     else
         _glfwInputError(GLFW_INVALID_ENUM, "Invalid input mode 0x%08X", mode);
 }
@@ -660,6 +866,23 @@ GLFWAPI void glfwGetCursorPos(GLFWwindow* handle, double* xpos, double* ypos)
         _glfwPlatformGetCursorPos(window, xpos, ypos);
 }
 
+GLFWAPI const double* glfwGetCursorHistory(GLFWwindow* handle, int* count)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(count != NULL);
+
+    *count = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (!window->historyCount)
+        return NULL;
+
+    *count = window->historyCount;
+    return window->history;
+}
+
 GLFWAPI void glfwSetCursorPos(GLFWwindow* handle, double xpos, double ypos)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
@@ -1273,6 +1496,28 @@ GLFWAPI const char* glfwGetClipboardString(GLFWwindow* handle)
     return _glfwPlatformGetClipboardString();
 }
 
+GLFWAPI void glfwRequestClipboardString(GLFWwindow* handle,
+                                        GLFWclipboardfun cbfun,
+                                        double timeout)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(cbfun != NULL);
+    assert(timeout == timeout);
+    assert(timeout >= 0.0);
+    assert(timeout <= DBL_MAX);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (timeout != timeout || timeout < 0.0 || timeout > DBL_MAX)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid time %f", timeout);
+        return;
+    }
+
+    _glfwPlatformRequestClipboardString(window, cbfun, timeout);
+}
+
 GLFWAPI double glfwGetTime(void)
 {
     _GLFW_REQUIRE_INIT_OR_RETURN(0.0);
@@ -248,6 +248,10 @@ struct _GLFWinitconfig
         GLFWbool  menubar;
         GLFWbool  chdir;
     } ns;
+    struct {
+        int       device;
+        int       renderDevice;
+    } drm;
 };
 
 // Window configuration
@@ -276,7 +280,13 @@ struct _GLFWwndconfig
     struct {
         char      className[256];
         char      instanceName[256];
+        GLFWbool  softwareSurface;
     } x11;
+    struct {
+        int       bufferCount;
+        GLFWbool  headless;
+        GLFWbool  adaptiveSync;
+    } drm;
 };
 
 // Context configuration
@@ -393,6 +403,30 @@ struct _GLFWwindow
     // Virtual cursor position when cursor is disabled
     double              virtualCursorPosX, virtualCursorPosY;
 
+    GLFWbool            coalesceEvents;
+    GLFWbool            cursorHistory;
+    // Events collapsed by event coalescing and not yet delivered, along with
+    // the serial of each, which orders their delivery by arrival
+    struct {
+        GLFWbool        cursorPos;
+        double          cursorPosX, cursorPosY;
+        unsigned int    cursorPosSerial;
+        GLFWbool        scroll;
+        double          scrollX, scrollY;
+        unsigned int    scrollSerial;
+        GLFWbool        size;
+        int             width, height;
+        unsigned int    sizeSerial;
+        GLFWbool        fbsize;
+        int             fbwidth, fbheight;
+        unsigned int    fbsizeSerial;
+        unsigned int    serial;
+    } pending;
+    // Cursor positions dropped by event coalescing, as x and y pairs
+    double*             history;
+    int                 historyCount;
+    int                 historySize;
+
     _GLFWcontext        context;
 
     struct {
@@ -578,6 +612,8 @@ struct _GLFWlibrary
     _GLFW_PLATFORM_LIBRARY_CONTEXT_STATE;
     // This is defined in the platform's joystick.h
     _GLFW_PLATFORM_LIBRARY_JOYSTICK_STATE;
+    // This is defined in the platform's poll.h
+    _GLFW_PLATFORM_LIBRARY_POLL_STATE;
     // This is defined in egl_context.h
     _GLFW_EGL_LIBRARY_CONTEXT_STATE;
     // This is defined in osmesa_context.h
@@ -620,6 +656,9 @@ void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
 
 void _glfwPlatformSetClipboardString(const char* string);
 const char* _glfwPlatformGetClipboardString(void);
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window,
+                                         GLFWclipboardfun cbfun,
+                                         double timeout);
 
 int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode);
 void _glfwPlatformUpdateGamepadGUID(char* guid);
@@ -675,6 +714,9 @@ void _glfwPlatformPollEvents(void);
 void _glfwPlatformWaitEvents(void);
 void _glfwPlatformWaitEventsTimeout(double timeout);
 void _glfwPlatformPostEmptyEvent(void);
+int _glfwPlatformWatchFileDescriptor(int fd, int events,
+                                     GLFWfdfun callback, void* pointer);
+void _glfwPlatformUnwatchFileDescriptor(int fd);
 
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions);
 int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
@@ -721,6 +763,10 @@ void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
 void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos);
 void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered);
 void _glfwInputDrop(_GLFWwindow* window, int count, const char** names);
+GLFWbool _glfwCoalesceEvent(_GLFWwindow* window,
+                            GLFWbool* pending, unsigned int* serial);
+GLFWbool _glfwFlushCoalescedEvent(_GLFWwindow* window);
+void _glfwFlushCoalescedEvents(_GLFWwindow* window);
 void _glfwInputJoystick(_GLFWjoystick* js, int event);
 void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value);
 void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value);
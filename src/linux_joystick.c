@@ -257,6 +257,14 @@ static int compareJoysticks(const void* fp, const void* sp)
     return strcmp(fj->linjs.path, sj->linjs.path);
 }
 
+// Processes device connection notifications that arrived while waiting for
+// events
+//
+static void handleInotifyEvents(int fd, short revents, void* userData)
+{
+    _glfwDetectJoystickConnectionLinux();
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -315,6 +323,14 @@ GLFWbool _glfwInitJoysticksLinux(void)
     // Continue with no joysticks if enumeration fails
 
     qsort(_glfw.joysticks, count, sizeof(_GLFWjoystick), compareJoysticks);
+
+    // Device connections wake up glfwWaitEvents
+    if (_glfw.linjs.inotify > 0)
+    {
+        _glfwAddPollSourcePOSIX(_glfw.linjs.inotify, POLLIN,
+                                handleInotifyEvents, NULL);
+    }
+
     return GLFW_TRUE;
 }
 
@@ -335,6 +351,8 @@ void _glfwTerminateJoysticksLinux(void)
 
     if (_glfw.linjs.inotify > 0)
     {
+        _glfwRemovePollSourcePOSIX(_glfw.linjs.inotify);
+
         if (_glfw.linjs.watch > 0)
             inotify_rm_watch(_glfw.linjs.inotify, _glfw.linjs.watch);
 
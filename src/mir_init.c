@@ -207,6 +207,9 @@ int _glfwPlatformInit(void)
         return GLFW_FALSE;
     }
 
+    if (!_glfwCreateEmptyEventPipePOSIX(_glfw.mir.emptyEventPipe))
+        return GLFW_FALSE;
+
     _glfwPollMonitorsMir();
     return GLFW_TRUE;
 }
@@ -221,6 +224,9 @@ void _glfwPlatformTerminate(void)
     pthread_mutex_destroy(&_glfw.mir.eventMutex);
 
     mir_connection_release(_glfw.mir.connection);
+
+    // Mir threads may queue events until the connection is released
+    _glfwDestroyEmptyEventPipePOSIX(_glfw.mir.emptyEventPipe);
 }
 
 const char* _glfwPlatformGetVersionString(void)
@@ -46,6 +46,7 @@ typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceMirPresentationSupportKHR)(Vk
 
 #include "posix_thread.h"
 #include "posix_time.h"
+#include "posix_poll.h"
 #include "linux_joystick.h"
 #include "xkb_unicode.h"
 #include "egl_context.h"
@@ -109,7 +110,9 @@ typedef struct _GLFWlibraryMir
     short int scancodes[GLFW_KEY_LAST + 1];
 
     pthread_mutex_t eventMutex;
-    pthread_cond_t  eventCond;
+    // Pipe written to when an event is queued or glfwPostEmptyEvent is called,
+    // to wake up event waits
+    int             emptyEventPipe[2];
 
     // The window whose disabled cursor mode is active
     _GLFWwindow* disabledCursorWindow;
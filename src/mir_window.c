@@ -68,9 +68,11 @@ static void enqueueEvent(const MirEvent* event, _GLFWwindow* context)
     EventNode* newNode = newEventNode(event, context);
     TAILQ_INSERT_TAIL(&_glfw.mir.eventQueue->head, newNode, entries);
 
-    pthread_cond_signal(&_glfw.mir.eventCond);
-
     pthread_mutex_unlock(&_glfw.mir.eventMutex);
+
+    // Events are queued from threads of the Mir client library, so a main
+    // thread waiting on event sources is woken up through the pipe
+    _glfwPostEmptyEventPOSIX(_glfw.mir.emptyEventPipe);
 }
 
 static EventNode* dequeueEvent(EventQueue* queue)
@@ -677,40 +679,43 @@ void _glfwPlatformPollEvents(void)
         handleEvent(node->event, node->window);
         deleteNode(_glfw.mir.eventQueue, node);
     }
+
+    _glfwDispatchEventSourcesPOSIX();
 }
 
 void _glfwPlatformWaitEvents(void)
 {
-    pthread_mutex_lock(&_glfw.mir.eventMutex);
-
-    while (emptyEventQueue(_glfw.mir.eventQueue))
-        pthread_cond_wait(&_glfw.mir.eventCond, &_glfw.mir.eventMutex);
+    GLFWbool empty;
 
+    pthread_mutex_lock(&_glfw.mir.eventMutex);
+    empty = emptyEventQueue(_glfw.mir.eventQueue);
     pthread_mutex_unlock(&_glfw.mir.eventMutex);
 
+    // Events queued after the check write to the empty event pipe, which is
+    // polled along with any watched file descriptors
+    if (empty)
+        _glfwWaitEventsPOSIX(NULL, 0, NULL);
+
     _glfwPlatformPollEvents();
 }
 
 void _glfwPlatformWaitEventsTimeout(double timeout)
 {
-    pthread_mutex_lock(&_glfw.mir.eventMutex);
-
-    if (emptyEventQueue(_glfw.mir.eventQueue))
-    {
-        struct timespec time;
-        clock_gettime(CLOCK_REALTIME, &time);
-        time.tv_sec += (long) timeout;
-        time.tv_nsec += (long) ((timeout - (long) timeout) * 1e9);
-        pthread_cond_timedwait(&_glfw.mir.eventCond, &_glfw.mir.eventMutex, &time);
-    }
+    GLFWbool empty;
 
+    pthread_mutex_lock(&_glfw.mir.eventMutex);
+    empty = emptyEventQueue(_glfw.mir.eventQueue);
     pthread_mutex_unlock(&_glfw.mir.eventMutex);
 
+    if (empty)
+        _glfwWaitEventsPOSIX(NULL, 0, &timeout);
+
     _glfwPlatformPollEvents();
 }
 
 void _glfwPlatformPostEmptyEvent(void)
 {
+    _glfwPostEmptyEventPOSIX(_glfw.mir.emptyEventPipe);
 }
 
 void _glfwPlatformGetFramebufferSize(_GLFWwindow* window, int* width, int* height)
@@ -892,6 +897,13 @@ const char* _glfwPlatformGetClipboardString(void)
     return NULL;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window,
+                                         GLFWclipboardfun cbfun,
+                                         double timeout)
+{
+    cbfun((GLFWwindow*) window, _glfwPlatformGetClipboardString());
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface || !_glfw.vk.KHR_mir_surface)
@@ -34,12 +34,16 @@
 
 int _glfwPlatformInit(void)
 {
+    if (!_glfwCreateEmptyEventPipePOSIX(_glfw.null.emptyEventPipe))
+        return GLFW_FALSE;
+
     _glfwInitTimerPOSIX();
     return GLFW_TRUE;
 }
 
 void _glfwPlatformTerminate(void)
 {
+    _glfwDestroyEmptyEventPipePOSIX(_glfw.null.emptyEventPipe);
     _glfwTerminateOSMesa();
 }
 
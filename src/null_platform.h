@@ -32,13 +32,14 @@
 #define _GLFW_PLATFORM_CONTEXT_STATE
 #define _GLFW_PLATFORM_MONITOR_STATE
 #define _GLFW_PLATFORM_CURSOR_STATE
-#define _GLFW_PLATFORM_LIBRARY_WINDOW_STATE
+#define _GLFW_PLATFORM_LIBRARY_WINDOW_STATE _GLFWlibraryNull null
 #define _GLFW_PLATFORM_LIBRARY_CONTEXT_STATE
 #define _GLFW_EGL_CONTEXT_STATE
 #define _GLFW_EGL_LIBRARY_CONTEXT_STATE
 
 #include "osmesa_context.h"
 #include "posix_time.h"
+#include "posix_poll.h"
 #include "posix_thread.h"
 #include "null_joystick.h"
 
@@ -60,3 +61,11 @@ typedef struct _GLFWwindowNull
     int height;
 } _GLFWwindowNull;
 
+// Null-specific global data
+//
+typedef struct _GLFWlibraryNull
+{
+    // Pipe written to by glfwPostEmptyEvent to wake up event waits
+    int emptyEventPipe[2];
+} _GLFWlibraryNull;
+
@@ -234,18 +234,33 @@ int _glfwPlatformWindowVisible(_GLFWwindow* window)
 
 void _glfwPlatformPollEvents(void)
 {
+    _glfwDispatchEventSourcesPOSIX();
 }
 
 void _glfwPlatformWaitEvents(void)
 {
+    int i;
+
+    // Without watched file descriptors there is nothing to wait for, as no
+    // window system produces events
+    for (i = 0;  i < _glfw.poll.count;  i++)
+    {
+        if (_glfw.poll.sources[i].fdCallback)
+        {
+            _glfwWaitEventsPOSIX(NULL, 0, NULL);
+            return;
+        }
+    }
 }
 
 void _glfwPlatformWaitEventsTimeout(double timeout)
 {
+    _glfwWaitEventsPOSIX(NULL, 0, &timeout);
 }
 
 void _glfwPlatformPostEmptyEvent(void)
 {
+    _glfwPostEmptyEventPOSIX(_glfw.null.emptyEventPipe);
 }
 
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
@@ -289,6 +304,13 @@ const char* _glfwPlatformGetClipboardString(void)
     return NULL;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window,
+                                         GLFWclipboardfun cbfun,
+                                         double timeout)
+{
+    cbfun((GLFWwindow*) window, NULL);
+}
+
 const char* _glfwPlatformGetScancodeName(int scancode)
 {
     return "";
@@ -0,0 +1,378 @@
+//========================================================================
+// GLFW 3.3 POSIX - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2016 Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+#define _GNU_SOURCE
+
+#include "internal.h"
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <assert.h>
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Adds a file descriptor to those polled while waiting for events
+//
+// The callback, if any, is called with the returned events each time the file
+// descriptor is ready and must consume whatever made it ready
+//
+GLFWbool _glfwAddPollSourcePOSIX(int fd, short events,
+                                 _GLFWpollfun callback, void* userData)
+{
+    _GLFWpollsourcePOSIX* source;
+
+    if (_glfw.poll.count == _GLFW_POLL_MAX_SOURCES)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY,
+                        "POSIX: Too many event sources");
+        return GLFW_FALSE;
+    }
+
+    source = _glfw.poll.sources + _glfw.poll.count++;
+    memset(source, 0, sizeof(_GLFWpollsourcePOSIX));
+    source->fd = fd;
+    source->events = events;
+    source->callback = callback;
+    source->userData = userData;
+    source->serial = ++_glfw.poll.serial;
+    return GLFW_TRUE;
+}
+
+// Returns the event source with the specified serial, or NULL if it has been
+// removed or replaced
+//
+static const _GLFWpollsourcePOSIX* findPollSource(unsigned int serial)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.poll.count;  i++)
+    {
+        if (_glfw.poll.sources[i].serial == serial)
+            return _glfw.poll.sources + i;
+    }
+
+    return NULL;
+}
+
+// Removes a file descriptor from those polled while waiting for events
+//
+void _glfwRemovePollSourcePOSIX(int fd)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.poll.count;  i++)
+    {
+        if (_glfw.poll.sources[i].fd == fd && !_glfw.poll.sources[i].fdCallback)
+        {
+            _glfw.poll.count--;
+            memmove(_glfw.poll.sources + i, _glfw.poll.sources + i + 1,
+                    (_glfw.poll.count - i) * sizeof(_GLFWpollsourcePOSIX));
+            return;
+        }
+    }
+}
+
+// Waits for any of the specified file descriptors to become ready, for at most
+// the specified number of seconds if a timeout is given
+//
+// The remaining time is written back to the timeout, which is also what waits
+// interrupted by signals are resumed with
+//
+// Returns GLFW_FALSE if the timeout elapsed or polling failed
+//
+GLFWbool _glfwPollPOSIX(struct pollfd* fds, nfds_t count, double* timeout)
+{
+    for (;;)
+    {
+        int result;
+
+        if (timeout)
+        {
+            struct timespec ts = { 0, 0 };
+            const uint64_t base = _glfwPlatformGetTimerValue();
+
+            if (*timeout > 0.0)
+            {
+                // Clamp waits far beyond any useful length to what time_t
+                // can hold, as timeouts up to DBL_MAX are allowed
+                const double seconds = *timeout < 1e9 ? *timeout : 1e9;
+
+                ts.tv_sec = (time_t) seconds;
+                ts.tv_nsec = (long) ((seconds - ts.tv_sec) * 1e9);
+            }
+
+            result = ppoll(fds, count, &ts, NULL);
+            const int error = errno;
+
+            *timeout -= (_glfwPlatformGetTimerValue() - base) /
+                (double) _glfwPlatformGetTimerFrequency();
+
+            errno = error;
+        }
+        else
+            result = ppoll(fds, count, NULL, NULL);
+
+        if (result > 0)
+            return GLFW_TRUE;
+        if (result == 0)
+            return GLFW_FALSE;
+
+        if (errno != EINTR && errno != EAGAIN)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "POSIX: Failed to poll for events: %s",
+                            strerror(errno));
+            return GLFW_FALSE;
+        }
+
+        // A signal interrupted the wait, so retry with whatever time is left
+        if (timeout && *timeout <= 0.0)
+            return GLFW_FALSE;
+    }
+}
+
+// Waits for any of the specified file descriptors or event sources to become
+// ready, for at most the specified number of seconds if a timeout is given
+//
+// The callbacks of ready event sources are called before returning
+//
+// Returns GLFW_FALSE if the timeout elapsed or polling failed
+//
+GLFWbool _glfwWaitEventsPOSIX(struct pollfd* fds, nfds_t count, double* timeout)
+{
+    int i;
+    nfds_t total = count;
+    struct pollfd all[_GLFW_POLL_MAX_FDS + _GLFW_POLL_MAX_SOURCES];
+    _GLFWpollsourcePOSIX sources[_GLFW_POLL_MAX_SOURCES];
+    const int sourceCount = _glfw.poll.count;
+
+    assert(count <= _GLFW_POLL_MAX_FDS);
+
+    // The sources are copied as callbacks may add, replace or remove sources
+    if (count)
+        memcpy(all, fds, count * sizeof(struct pollfd));
+    memcpy(sources, _glfw.poll.sources,
+           sourceCount * sizeof(_GLFWpollsourcePOSIX));
+
+    for (i = 0;  i < sourceCount;  i++)
+    {
+        all[total].fd = sources[i].fd;
+        all[total].events = sources[i].events;
+        all[total].revents = 0;
+        total++;
+    }
+
+    if (!_glfwPollPOSIX(all, total, timeout))
+        return GLFW_FALSE;
+
+    if (count)
+        memcpy(fds, all, count * sizeof(struct pollfd));
+
+    for (i = 0;  i < sourceCount;  i++)
+    {
+        const _GLFWpollsourcePOSIX* source;
+        const short revents = all[count + i].revents;
+        if (!revents)
+            continue;
+
+        // An earlier callback may have removed or replaced this source, in
+        // which case its callback and user data must not be used
+        source = findPollSource(sources[i].serial);
+        if (!source)
+            continue;
+
+        if (source->callback)
+            source->callback(source->fd, revents, source->userData);
+        else if (source->fdCallback)
+        {
+            int events = 0;
+
+            if (revents & POLLIN)
+                events |= GLFW_FD_READABLE;
+            if (revents & POLLOUT)
+                events |= GLFW_FD_WRITABLE;
+            if (revents & (POLLERR | POLLHUP | POLLNVAL))
+                events |= GLFW_FD_ERROR;
+
+            source->fdCallback(source->fd, events, source->userData);
+        }
+    }
+
+    return GLFW_TRUE;
+}
+
+// Drains an empty event pipe once a wait has been woken up by it
+//
+static void drainEmptyEvents(int fd, short revents, void* userData)
+{
+    for (;;)
+    {
+        char dummy[64];
+        const ssize_t result = read(fd, dummy, sizeof(dummy));
+        if (result > 0 || (result == -1 && errno == EINTR))
+            continue;
+
+        break;
+    }
+}
+
+// Creates a pipe that wakes up event waits when written to, and adds its read
+// end to the event sources
+//
+// This lets other threads post empty events without taking any lock of the
+// window system connection
+//
+GLFWbool _glfwCreateEmptyEventPipePOSIX(int fds[2])
+{
+    int i;
+
+    if (pipe(fds) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "POSIX: Failed to create empty event pipe: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    for (i = 0;  i < 2;  i++)
+    {
+        const int sf = fcntl(fds[i], F_GETFL, 0);
+        const int df = fcntl(fds[i], F_GETFD, 0);
+
+        if (sf == -1 || df == -1 ||
+            fcntl(fds[i], F_SETFL, sf | O_NONBLOCK) == -1 ||
+            fcntl(fds[i], F_SETFD, df | FD_CLOEXEC) == -1)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "POSIX: Failed to set flags for empty event pipe: %s",
+                            strerror(errno));
+            return GLFW_FALSE;
+        }
+    }
+
+    return _glfwAddPollSourcePOSIX(fds[0], POLLIN, drainEmptyEvents, NULL);
+}
+
+// Removes an empty event pipe from the event sources and closes it, if it was
+// created
+//
+void _glfwDestroyEmptyEventPipePOSIX(int fds[2])
+{
+    if (fds[0] || fds[1])
+    {
+        _glfwRemovePollSourcePOSIX(fds[0]);
+
+        close(fds[0]);
+        close(fds[1]);
+    }
+}
+
+// Wakes up any thread waiting for events through an empty event pipe
+//
+void _glfwPostEmptyEventPOSIX(int fds[2])
+{
+    // A full pipe already has a wake-up pending
+    for (;;)
+    {
+        const char byte = 0;
+        const ssize_t result = write(fds[1], &byte, 1);
+        if (result == 1 || (result == -1 && errno != EINTR))
+            break;
+    }
+}
+
+// Calls the callbacks of the event sources that are already ready
+//
+void _glfwDispatchEventSourcesPOSIX(void)
+{
+    double timeout = 0.0;
+
+    if (_glfw.poll.count)
+        _glfwWaitEventsPOSIX(NULL, 0, &timeout);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW platform API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+int _glfwPlatformWatchFileDescriptor(int fd, int events,
+                                     GLFWfdfun callback, void* pointer)
+{
+    int i;
+    short pollEvents = 0;
+
+    if (events & GLFW_FD_READABLE)
+        pollEvents |= POLLIN;
+    if (events & GLFW_FD_WRITABLE)
+        pollEvents |= POLLOUT;
+
+    // Watching a file descriptor again only replaces how it is watched
+    for (i = 0;  i < _glfw.poll.count;  i++)
+    {
+        _GLFWpollsourcePOSIX* source = _glfw.poll.sources + i;
+
+        if (source->fd == fd && source->fdCallback)
+        {
+            source->events = pollEvents;
+            source->fdCallback = callback;
+            source->userData = pointer;
+            source->serial = ++_glfw.poll.serial;
+            return GLFW_TRUE;
+        }
+    }
+
+    if (!_glfwAddPollSourcePOSIX(fd, pollEvents, NULL, pointer))
+        return GLFW_FALSE;
+
+    _glfw.poll.sources[_glfw.poll.count - 1].fdCallback = callback;
+    return GLFW_TRUE;
+}
+
+void _glfwPlatformUnwatchFileDescriptor(int fd)
+{
+    int i;
+
+    // Event sources of GLFW itself are never removed by the application
+    for (i = 0;  i < _glfw.poll.count;  i++)
+    {
+        if (_glfw.poll.sources[i].fd == fd && _glfw.poll.sources[i].fdCallback)
+        {
+            _glfw.poll.count--;
+            memmove(_glfw.poll.sources + i, _glfw.poll.sources + i + 1,
+                    (_glfw.poll.count - i) * sizeof(_GLFWpollsourcePOSIX));
+            return;
+        }
+    }
+}
+
@@ -0,0 +1,72 @@
+//========================================================================
+// GLFW 3.3 POSIX - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2016 Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+#define _GLFW_PLATFORM_LIBRARY_POLL_STATE _GLFWpollPOSIX poll
+
+#include <poll.h>
+
+#define _GLFW_POLL_MAX_SOURCES 16
+#define _GLFW_POLL_MAX_FDS     8
+
+typedef void (* _GLFWpollfun)(int,short,void*);
+
+// POSIX-specific event source data
+//
+typedef struct _GLFWpollsourcePOSIX
+{
+    int             fd;
+    short           events;
+    _GLFWpollfun    callback;
+    // The application callback of a watched file descriptor
+    GLFWfdfun       fdCallback;
+    void*           userData;
+    // Changes whenever the source is added or its callback replaced
+    unsigned int    serial;
+
+} _GLFWpollsourcePOSIX;
+
+// POSIX-specific global event source data
+//
+typedef struct _GLFWpollPOSIX
+{
+    _GLFWpollsourcePOSIX sources[_GLFW_POLL_MAX_SOURCES];
+    int             count;
+    unsigned int    serial;
+
+} _GLFWpollPOSIX;
+
+
+GLFWbool _glfwAddPollSourcePOSIX(int fd, short events,
+                                 _GLFWpollfun callback, void* userData);
+void _glfwRemovePollSourcePOSIX(int fd);
+GLFWbool _glfwPollPOSIX(struct pollfd* fds, nfds_t count, double* timeout);
+GLFWbool _glfwWaitEventsPOSIX(struct pollfd* fds, nfds_t count, double* timeout);
+void _glfwDispatchEventSourcesPOSIX(void);
+GLFWbool _glfwCreateEmptyEventPipePOSIX(int fds[2]);
+void _glfwDestroyEmptyEventPipePOSIX(int fds[2]);
+void _glfwPostEmptyEventPOSIX(int fds[2]);
+
@@ -256,6 +256,7 @@ typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceWin32PresentationSupportKHR)(
 #define _GLFW_PLATFORM_CURSOR_STATE         _GLFWcursorWin32  win32
 #define _GLFW_PLATFORM_TLS_STATE            _GLFWtlsWin32     win32
 #define _GLFW_PLATFORM_MUTEX_STATE          _GLFWmutexWin32   win32
+#define _GLFW_PLATFORM_LIBRARY_POLL_STATE
 
 
 // Win32-specific per-window data
@@ -1741,6 +1741,18 @@ void _glfwPlatformPostEmptyEvent(void)
     PostMessage(_glfw.win32.helperWindowHandle, WM_NULL, 0, 0);
 }
 
+int _glfwPlatformWatchFileDescriptor(int fd, int events,
+                                     GLFWfdfun callback, void* pointer)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Win32: File descriptors cannot be watched");
+    return GLFW_FALSE;
+}
+
+void _glfwPlatformUnwatchFileDescriptor(int fd)
+{
+}
+
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
 {
     POINT pos;
@@ -1937,6 +1949,13 @@ const char* _glfwPlatformGetClipboardString(void)
     return _glfw.win32.clipboardString;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window,
+                                         GLFWclipboardfun cbfun,
+                                         double timeout)
+{
+    cbfun((GLFWwindow*) window, _glfwPlatformGetClipboardString());
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface || !_glfw.vk.KHR_win32_surface)
@@ -34,6 +34,24 @@
 #include <float.h>
 
 
+// Delivers the events collapsed by event coalescing for all windows
+//
+static void flushCoalescedEvents(void)
+{
+    _GLFWwindow* window = _glfw.windowListHead;
+
+    while (window)
+    {
+        // A callback may destroy any window, so no window pointer is used
+        // after one has run and the list is walked again from its head
+        if (_glfwFlushCoalescedEvent(window))
+            window = _glfw.windowListHead;
+        else
+            window = window->next;
+    }
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -42,6 +60,8 @@
 //
 void _glfwInputWindowFocus(_GLFWwindow* window, GLFWbool focused)
 {
+    _glfwFlushCoalescedEvents(window);
+
     if (window->callbacks.focus)
         window->callbacks.focus((GLFWwindow*) window, focused);
 
@@ -71,6 +91,8 @@ void _glfwInputWindowFocus(_GLFWwindow* window, GLFWbool focused)
 //
 void _glfwInputWindowPos(_GLFWwindow* window, int x, int y)
 {
+    _glfwFlushCoalescedEvents(window);
+
     if (window->callbacks.pos)
         window->callbacks.pos((GLFWwindow*) window, x, y);
 }
@@ -80,6 +102,15 @@ void _glfwInputWindowPos(_GLFWwindow* window, int x, int y)
 //
 void _glfwInputWindowSize(_GLFWwindow* window, int width, int height)
 {
+    if (window->coalesceEvents)
+    {
+        _glfwCoalesceEvent(window, &window->pending.size,
+                           &window->pending.sizeSerial);
+        window->pending.width = width;
+        window->pending.height = height;
+        return;
+    }
+
     if (window->callbacks.size)
         window->callbacks.size((GLFWwindow*) window, width, height);
 }
@@ -88,6 +119,8 @@ void _glfwInputWindowSize(_GLFWwindow* window, int width, int height)
 //
 void _glfwInputWindowIconify(_GLFWwindow* window, GLFWbool iconified)
 {
+    _glfwFlushCoalescedEvents(window);
+
     if (window->callbacks.iconify)
         window->callbacks.iconify((GLFWwindow*) window, iconified);
 }
@@ -96,6 +129,8 @@ void _glfwInputWindowIconify(_GLFWwindow* window, GLFWbool iconified)
 //
 void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized)
 {
+    _glfwFlushCoalescedEvents(window);
+
     if (window->callbacks.maximize)
         window->callbacks.maximize((GLFWwindow*) window, maximized);
 }
@@ -105,6 +140,15 @@ void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized)
 //
 void _glfwInputFramebufferSize(_GLFWwindow* window, int width, int height)
 {
+    if (window->coalesceEvents)
+    {
+        _glfwCoalesceEvent(window, &window->pending.fbsize,
+                           &window->pending.fbsizeSerial);
+        window->pending.fbwidth = width;
+        window->pending.fbheight = height;
+        return;
+    }
+
     if (window->callbacks.fbsize)
         window->callbacks.fbsize((GLFWwindow*) window, width, height);
 }
@@ -114,6 +158,8 @@ void _glfwInputFramebufferSize(_GLFWwindow* window, int width, int height)
 //
 void _glfwInputWindowContentScale(_GLFWwindow* window, float xscale, float yscale)
 {
+    _glfwFlushCoalescedEvents(window);
+
     if (window->callbacks.scale)
         window->callbacks.scale((GLFWwindow*) window, xscale, yscale);
 }
@@ -122,6 +168,8 @@ void _glfwInputWindowContentScale(_GLFWwindow* window, float xscale, float yscal
 //
 void _glfwInputWindowDamage(_GLFWwindow* window)
 {
+    _glfwFlushCoalescedEvents(window);
+
     if (window->callbacks.refresh)
         window->callbacks.refresh((GLFWwindow*) window);
 }
@@ -130,6 +178,8 @@ void _glfwInputWindowDamage(_GLFWwindow* window)
 //
 void _glfwInputWindowCloseRequest(_GLFWwindow* window)
 {
+    _glfwFlushCoalescedEvents(window);
+
     window->shouldClose = GLFW_TRUE;
 
     if (window->callbacks.close)
@@ -284,6 +334,9 @@ void glfwDefaultWindowHints(void)
 
     // The default is to use full Retina resolution framebuffers
     _glfw.hints.window.ns.retina = GLFW_TRUE;
+
+    // The default is double buffered scanout
+    _glfw.hints.window.drm.bufferCount = 2;
 }
 
 GLFWAPI void glfwWindowHint(int hint, int value)
@@ -370,6 +423,18 @@ GLFWAPI void glfwWindowHint(int hint, int value)
         case GLFW_CENTER_CURSOR:
             _glfw.hints.window.centerCursor = value ? GLFW_TRUE : GLFW_FALSE;
             return;
+        case GLFW_X11_SOFTWARE_SURFACE:
+            _glfw.hints.window.x11.softwareSurface = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
+        case GLFW_DRM_BUFFER_COUNT:
+            _glfw.hints.window.drm.bufferCount = value;
+            return;
+        case GLFW_DRM_HEADLESS:
+            _glfw.hints.window.drm.headless = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
+        case GLFW_DRM_ADAPTIVE_SYNC:
+            _glfw.hints.window.drm.adaptiveSync = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
         case GLFW_CLIENT_API:
             _glfw.hints.context.client = value;
             return;
@@ -463,6 +528,7 @@ GLFWAPI void glfwDestroyWindow(GLFWwindow* handle)
         *prev = window->next;
     }
 
+    free(window->history);
     free(window);
 }
 
@@ -1059,6 +1125,7 @@ GLFWAPI void glfwPollEvents(void)
 {
     _GLFW_REQUIRE_INIT();
     _glfwPlatformPollEvents();
+    flushCoalescedEvents();
 }
 
 GLFWAPI void glfwWaitEvents(void)
@@ -1069,6 +1136,7 @@ GLFWAPI void glfwWaitEvents(void)
         return;
 
     _glfwPlatformWaitEvents();
+    flushCoalescedEvents();
 }
 
 GLFWAPI void glfwWaitEventsTimeout(double timeout)
@@ -1085,6 +1153,7 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout)
     }
 
     _glfwPlatformWaitEventsTimeout(timeout);
+    flushCoalescedEvents();
 }
 
 GLFWAPI void glfwPostEmptyEvent(void)
@@ -1097,3 +1166,32 @@ GLFWAPI void glfwPostEmptyEvent(void)
     _glfwPlatformPostEmptyEvent();
 }
 
+GLFWAPI int glfwWatchFileDescriptor(int fd, int events,
+                                    GLFWfdfun callback, void* pointer)
+{
+    assert(callback != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (fd < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid file descriptor %i", fd);
+        return GLFW_FALSE;
+    }
+
+    if (events & ~(GLFW_FD_READABLE | GLFW_FD_WRITABLE))
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid file descriptor conditions 0x%08X", events);
+        return GLFW_FALSE;
+    }
+
+    return _glfwPlatformWatchFileDescriptor(fd, events, callback, pointer);
+}
+
+GLFWAPI void glfwUnwatchFileDescriptor(int fd)
+{
+    _GLFW_REQUIRE_INIT();
+    _glfwPlatformUnwatchFileDescriptor(fd);
+}
+
@@ -47,6 +47,7 @@ typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceWaylandPresentationSupportKHR
 
 #include "posix_thread.h"
 #include "posix_time.h"
+#include "posix_poll.h"
 #ifdef __linux__
 #include "linux_joystick.h"
 #else
@@ -691,7 +691,7 @@ static GLFWbool createXdgSurface(_GLFWwindow* window)
 }
 
 static void
-handleEvents(int timeout)
+handleEvents(double* timeout)
 {
     struct wl_display* display = _glfw.wl.display;
     struct pollfd fds[] = {
@@ -719,7 +719,7 @@ handleEvents(int timeout)
         return;
     }
 
-    if (poll(fds, 2, timeout) > 0)
+    if (_glfwWaitEventsPOSIX(fds, 2, timeout))
     {
         if (fds[0].revents & POLLIN)
         {
@@ -1176,17 +1176,18 @@ void _glfwPlatformSetWindowOpacity(_GLFWwindow* window, float opacity)
 
 void _glfwPlatformPollEvents(void)
 {
-    handleEvents(0);
+    double timeout = 0.0;
+    handleEvents(&timeout);
 }
 
 void _glfwPlatformWaitEvents(void)
 {
-    handleEvents(-1);
+    handleEvents(NULL);
 }
 
 void _glfwPlatformWaitEventsTimeout(double timeout)
 {
-    handleEvents((int) (timeout * 1e3));
+    handleEvents(&timeout);
 }
 
 void _glfwPlatformPostEmptyEvent(void)
@@ -1459,6 +1460,13 @@ const char* _glfwPlatformGetClipboardString(void)
     return NULL;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window,
+                                         GLFWclipboardfun cbfun,
+                                         double timeout)
+{
+    cbfun((GLFWwindow*) window, _glfwPlatformGetClipboardString());
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface || !_glfw.vk.KHR_wayland_surface)
@@ -584,12 +584,19 @@ static GLFWbool initExtensions(void)
             _glfw.x11.randr.monitorBroken = GLFW_TRUE;
         }
 
-        XRRFreeScreenResources(sr);
+        // Keep the resources for the monitor module, which caches them
+        if (_glfw.x11.randr.monitorBroken)
+            XRRFreeScreenResources(sr);
+        else
+            _glfw.x11.randr.resources = sr;
     }
 
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
+        // Any of these changes invalidates the cached monitor state
         XRRSelectInput(_glfw.x11.display, _glfw.x11.root,
+                       RRScreenChangeNotifyMask |
+                       RRCrtcChangeNotifyMask |
                        RROutputChangeNotifyMask);
     }
 
@@ -674,6 +681,56 @@ static GLFWbool initExtensions(void)
         }
     }
 
+    _glfw.x11.shm.handle = _glfw_dlopen("libXext.so.6");
+    if (_glfw.x11.shm.handle)
+    {
+        _glfw.x11.shm.QueryExtension = (PFN_XShmQueryExtension)
+            _glfw_dlsym(_glfw.x11.shm.handle, "XShmQueryExtension");
+        _glfw.x11.shm.GetEventBase = (PFN_XShmGetEventBase)
+            _glfw_dlsym(_glfw.x11.shm.handle, "XShmGetEventBase");
+        _glfw.x11.shm.CreateImage = (PFN_XShmCreateImage)
+            _glfw_dlsym(_glfw.x11.shm.handle, "XShmCreateImage");
+        _glfw.x11.shm.Attach = (PFN_XShmAttach)
+            _glfw_dlsym(_glfw.x11.shm.handle, "XShmAttach");
+        _glfw.x11.shm.Detach = (PFN_XShmDetach)
+            _glfw_dlsym(_glfw.x11.shm.handle, "XShmDetach");
+        _glfw.x11.shm.PutImage = (PFN_XShmPutImage)
+            _glfw_dlsym(_glfw.x11.shm.handle, "XShmPutImage");
+
+        if (XShmQueryExtension(_glfw.x11.display))
+        {
+            _glfw.x11.shm.eventBase = XShmGetEventBase(_glfw.x11.display);
+            _glfw.x11.shm.available = GLFW_TRUE;
+        }
+    }
+
+    _glfw.x11.present.handle = _glfw_dlopen("libXpresent.so.1");
+    if (_glfw.x11.present.handle)
+    {
+        _glfw.x11.present.QueryExtension = (PFN_XPresentQueryExtension)
+            _glfw_dlsym(_glfw.x11.present.handle, "XPresentQueryExtension");
+        _glfw.x11.present.QueryVersion = (PFN_XPresentQueryVersion)
+            _glfw_dlsym(_glfw.x11.present.handle, "XPresentQueryVersion");
+        _glfw.x11.present.SelectInput = (PFN_XPresentSelectInput)
+            _glfw_dlsym(_glfw.x11.present.handle, "XPresentSelectInput");
+
+        if (XPresentQueryExtension(_glfw.x11.display,
+                                   &_glfw.x11.present.majorOpcode,
+                                   &_glfw.x11.present.eventBase,
+                                   &_glfw.x11.present.errorBase))
+        {
+            _glfw.x11.present.major = 1;
+            _glfw.x11.present.minor = 0;
+
+            if (XPresentQueryVersion(_glfw.x11.display,
+                                     &_glfw.x11.present.major,
+                                     &_glfw.x11.present.minor))
+            {
+                _glfw.x11.present.available = GLFW_TRUE;
+            }
+        }
+    }
+
     // Update the key code LUT
     // FIXME: We should listen to XkbMapNotify events to track changes to
     // the keyboard mapping.
@@ -936,6 +993,9 @@ int _glfwPlatformInit(void)
     if (!initExtensions())
         return GLFW_FALSE;
 
+    if (!_glfwCreateEmptyEventPipePOSIX(_glfw.x11.emptyEventPipe))
+        return GLFW_FALSE;
+
     _glfw.x11.helperWindowHandle = createHelperWindow();
     _glfw.x11.hiddenCursorHandle = createHiddenCursor();
 
@@ -988,12 +1048,24 @@ void _glfwPlatformTerminate(void)
     free(_glfw.x11.primarySelectionString);
     free(_glfw.x11.clipboardString);
 
+    while (_glfw.x11.transferCount)
+        free(_glfw.x11.transfers[--_glfw.x11.transferCount].data);
+    free(_glfw.x11.transfers);
+
     if (_glfw.x11.im)
     {
         XCloseIM(_glfw.x11.im);
         _glfw.x11.im = NULL;
     }
 
+    _glfwDestroyEmptyEventPipePOSIX(_glfw.x11.emptyEventPipe);
+
+    if (_glfw.x11.randr.resources)
+    {
+        XRRFreeScreenResources(_glfw.x11.randr.resources);
+        _glfw.x11.randr.resources = NULL;
+    }
+
     if (_glfw.x11.display)
     {
         XCloseDisplay(_glfw.x11.display);
@@ -1024,6 +1096,18 @@ void _glfwPlatformTerminate(void)
         _glfw.x11.xinerama.handle = NULL;
     }
 
+    if (_glfw.x11.shm.handle)
+    {
+        _glfw_dlclose(_glfw.x11.shm.handle);
+        _glfw.x11.shm.handle = NULL;
+    }
+
+    if (_glfw.x11.present.handle)
+    {
+        _glfw_dlclose(_glfw.x11.present.handle);
+        _glfw.x11.present.handle = NULL;
+    }
+
     // NOTE: These need to be unloaded after XCloseDisplay, as they register
     //       cleanup callbacks that get called by that function
     _glfwTerminateEGL();
@@ -90,6 +90,66 @@ static GLFWvidmode vidmodeFromModeInfo(const XRRModeInfo* mi,
     return mode;
 }
 
+// Returns the screen resources, querying the server only if they are not cached
+//
+static XRRScreenResources* getScreenResources(void)
+{
+    if (!_glfw.x11.randr.resources)
+    {
+        _glfw.x11.randr.resources =
+            XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
+    }
+
+    return _glfw.x11.randr.resources;
+}
+
+// Returns the CRTC info of the monitor, querying the server only if it is not
+// cached
+//
+static XRRCrtcInfo* getCrtcInfo(_GLFWmonitor* monitor)
+{
+    if (!monitor->x11.crtcInfo)
+    {
+        monitor->x11.crtcInfo = XRRGetCrtcInfo(_glfw.x11.display,
+                                               getScreenResources(),
+                                               monitor->x11.crtc);
+    }
+
+    return monitor->x11.crtcInfo;
+}
+
+// Returns the output info of the monitor, querying the server only if it is
+// not cached
+//
+static XRROutputInfo* getOutputInfo(_GLFWmonitor* monitor)
+{
+    if (!monitor->x11.outputInfo)
+    {
+        monitor->x11.outputInfo = XRRGetOutputInfo(_glfw.x11.display,
+                                                   getScreenResources(),
+                                                   monitor->x11.output);
+    }
+
+    return monitor->x11.outputInfo;
+}
+
+// Frees the cached CRTC and output info of the monitor
+//
+static void invalidateMonitor(_GLFWmonitor* monitor)
+{
+    if (monitor->x11.crtcInfo)
+    {
+        XRRFreeCrtcInfo(monitor->x11.crtcInfo);
+        monitor->x11.crtcInfo = NULL;
+    }
+
+    if (monitor->x11.outputInfo)
+    {
+        XRRFreeOutputInfo(monitor->x11.outputInfo);
+        monitor->x11.outputInfo = NULL;
+    }
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -104,11 +164,15 @@ void _glfwPollMonitorsX11(void)
         int i, j, disconnectedCount, screenCount = 0;
         _GLFWmonitor** disconnected = NULL;
         XineramaScreenInfo* screens = NULL;
-        XRRScreenResources* sr = XRRGetScreenResourcesCurrent(_glfw.x11.display,
-                                                              _glfw.x11.root);
+        XRRScreenResources* sr = getScreenResources();
+        const unsigned int invalidations = _glfw.x11.randr.invalidations;
         RROutput primary = XRRGetOutputPrimary(_glfw.x11.display,
                                                _glfw.x11.root);
 
+        // Monitor callbacks may change the configuration and invalidate the
+        // cache, so the poll holds its own reference to the resources
+        _glfw.x11.randr.resources = NULL;
+
         if (_glfw.x11.xinerama.available)
             screens = XineramaQueryScreens(_glfw.x11.display, &screenCount);
 
@@ -166,6 +230,9 @@ void _glfwPollMonitorsX11(void)
             monitor = _glfwAllocMonitor(oi->name, widthMM, heightMM);
             monitor->x11.output = sr->outputs[i];
             monitor->x11.crtc   = oi->crtc;
+            // Keep the fresh info for later queries of the new monitor
+            monitor->x11.outputInfo = oi;
+            monitor->x11.crtcInfo   = ci;
 
             for (j = 0;  j < screenCount;  j++)
             {
@@ -185,13 +252,8 @@ void _glfwPollMonitorsX11(void)
                 type = _GLFW_INSERT_LAST;
 
             _glfwInputMonitor(monitor, GLFW_CONNECTED, type);
-
-            XRRFreeOutputInfo(oi);
-            XRRFreeCrtcInfo(ci);
         }
 
-        XRRFreeScreenResources(sr);
-
         if (screens)
             XFree(screens);
 
@@ -201,6 +263,15 @@ void _glfwPollMonitorsX11(void)
                 _glfwInputMonitor(disconnected[i], GLFW_DISCONNECTED, 0);
         }
 
+        // The resources are only cached again if they are still current
+        if (_glfw.x11.randr.resources ||
+            _glfw.x11.randr.invalidations != invalidations)
+        {
+            XRRFreeScreenResources(sr);
+        }
+        else
+            _glfw.x11.randr.resources = sr;
+
         free(disconnected);
     }
     else
@@ -214,6 +285,24 @@ void _glfwPollMonitorsX11(void)
     }
 }
 
+// Discards the cached RandR state of the screen and all monitors
+//
+void _glfwInvalidateMonitorsX11(void)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.monitorCount;  i++)
+        invalidateMonitor(_glfw.monitors[i]);
+
+    _glfw.x11.randr.invalidations++;
+
+    if (_glfw.x11.randr.resources)
+    {
+        XRRFreeScreenResources(_glfw.x11.randr.resources);
+        _glfw.x11.randr.resources = NULL;
+    }
+}
+
 // Set the current video mode for the specified monitor
 //
 void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired)
@@ -233,9 +322,9 @@ void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired)
         if (_glfwCompareVideoModes(&current, best) == 0)
             return;
 
-        sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
-        ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
-        oi = XRRGetOutputInfo(_glfw.x11.display, sr, monitor->x11.output);
+        sr = getScreenResources();
+        ci = getCrtcInfo(monitor);
+        oi = getOutputInfo(monitor);
 
         for (i = 0;  i < oi->nmode;  i++)
         {
@@ -264,11 +353,10 @@ void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired)
                              ci->rotation,
                              ci->outputs,
                              ci->noutput);
-        }
 
-        XRRFreeOutputInfo(oi);
-        XRRFreeCrtcInfo(ci);
-        XRRFreeScreenResources(sr);
+            // Do not serve the old mode until the change is notified
+            _glfwInvalidateMonitorsX11();
+        }
     }
 }
 
@@ -284,8 +372,8 @@ void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor)
         if (monitor->x11.oldMode == None)
             return;
 
-        sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
-        ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+        sr = getScreenResources();
+        ci = getCrtcInfo(monitor);
 
         XRRSetCrtcConfig(_glfw.x11.display,
                          sr, monitor->x11.crtc,
@@ -296,8 +384,8 @@ void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor)
                          ci->outputs,
                          ci->noutput);
 
-        XRRFreeCrtcInfo(ci);
-        XRRFreeScreenResources(sr);
+        // Do not serve the old mode until the change is notified
+        _glfwInvalidateMonitorsX11();
 
         monitor->x11.oldMode = None;
     }
@@ -310,25 +398,20 @@ void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor)
 
 void _glfwPlatformFreeMonitor(_GLFWmonitor* monitor)
 {
+    if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
+        invalidateMonitor(monitor);
 }
 
 void _glfwPlatformGetMonitorPos(_GLFWmonitor* monitor, int* xpos, int* ypos)
 {
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
-        XRRScreenResources* sr;
-        XRRCrtcInfo* ci;
-
-        sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
-        ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+        const XRRCrtcInfo* ci = getCrtcInfo(monitor);
 
         if (xpos)
             *xpos = ci->x;
         if (ypos)
             *ypos = ci->y;
-
-        XRRFreeCrtcInfo(ci);
-        XRRFreeScreenResources(sr);
     }
 }
 
@@ -354,9 +437,9 @@ GLFWvidmode* _glfwPlatformGetVideoModes(_GLFWmonitor* monitor, int* count)
         XRRCrtcInfo* ci;
         XRROutputInfo* oi;
 
-        sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
-        ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
-        oi = XRRGetOutputInfo(_glfw.x11.display, sr, monitor->x11.output);
+        sr = getScreenResources();
+        ci = getCrtcInfo(monitor);
+        oi = getOutputInfo(monitor);
 
         result = calloc(oi->nmode, sizeof(GLFWvidmode));
 
@@ -381,10 +464,6 @@ GLFWvidmode* _glfwPlatformGetVideoModes(_GLFWmonitor* monitor, int* count)
             (*count)++;
             result[*count - 1] = mode;
         }
-
-        XRRFreeOutputInfo(oi);
-        XRRFreeCrtcInfo(ci);
-        XRRFreeScreenResources(sr);
     }
     else
     {
@@ -400,16 +479,9 @@ void _glfwPlatformGetVideoMode(_GLFWmonitor* monitor, GLFWvidmode* mode)
 {
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
-        XRRScreenResources* sr;
-        XRRCrtcInfo* ci;
-
-        sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
-        ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
-
-        *mode = vidmodeFromModeInfo(getModeInfo(sr, ci->mode), ci);
-
-        XRRFreeCrtcInfo(ci);
-        XRRFreeScreenResources(sr);
+        const XRRCrtcInfo* ci = getCrtcInfo(monitor);
+        *mode = vidmodeFromModeInfo(getModeInfo(getScreenResources(), ci->mode),
+                                    ci);
     }
     else
     {
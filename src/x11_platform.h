@@ -47,6 +47,9 @@
 // The XInput extension provides raw mouse motion input
 #include <X11/extensions/XInput2.h>
 
+// The MIT-SHM extension provides shared memory software surfaces
+#include <X11/extensions/XShm.h>
+
 typedef XRRCrtcGamma* (* PFN_XRRAllocGamma)(int);
 typedef void (* PFN_XRRFreeCrtcInfo)(XRRCrtcInfo*);
 typedef void (* PFN_XRRFreeGamma)(XRRCrtcGamma*);
@@ -123,6 +126,51 @@ typedef XRenderPictFormat* (* PFN_XRenderFindVisualFormat)(Display*,Visual const
 #define XRenderQueryVersion _glfw.x11.xrender.QueryVersion
 #define XRenderFindVisualFormat _glfw.x11.xrender.FindVisualFormat
 
+typedef Bool (* PFN_XShmQueryExtension)(Display*);
+typedef int (* PFN_XShmGetEventBase)(Display*);
+typedef XImage* (* PFN_XShmCreateImage)(Display*,Visual*,unsigned int,int,char*,XShmSegmentInfo*,unsigned int,unsigned int);
+typedef Bool (* PFN_XShmAttach)(Display*,XShmSegmentInfo*);
+typedef Bool (* PFN_XShmDetach)(Display*,XShmSegmentInfo*);
+typedef Bool (* PFN_XShmPutImage)(Display*,Drawable,GC,XImage*,int,int,int,int,unsigned int,unsigned int,Bool);
+#define XShmQueryExtension _glfw.x11.shm.QueryExtension
+#define XShmGetEventBase _glfw.x11.shm.GetEventBase
+#define XShmCreateImage _glfw.x11.shm.CreateImage
+#define XShmAttach _glfw.x11.shm.Attach
+#define XShmDetach _glfw.x11.shm.Detach
+#define XShmPutImage _glfw.x11.shm.PutImage
+
+// The Present extension provides frame completion events
+// Its declarations are copied here as libXpresent is optional at runtime and
+// its headers are therefore not required at build time either
+#define PresentCompleteNotify 1
+#define PresentCompleteNotifyMask 2
+#define PresentCompleteKindPixmap 0
+#define PresentCompleteModeSkip 2
+
+typedef struct
+{
+    int type;
+    unsigned long serial;
+    Bool send_event;
+    Display* display;
+    int extension;
+    int evtype;
+    uint32_t eid;
+    Window window;
+    uint32_t serial_number;
+    uint64_t ust;
+    uint64_t msc;
+    uint8_t kind;
+    uint8_t mode;
+} XPresentCompleteNotifyEvent;
+
+typedef Bool (* PFN_XPresentQueryExtension)(Display*,int*,int*,int*);
+typedef Status (* PFN_XPresentQueryVersion)(Display*,int*,int*);
+typedef XID (* PFN_XPresentSelectInput)(Display*,Window,unsigned);
+#define XPresentQueryExtension _glfw.x11.present.QueryExtension
+#define XPresentQueryVersion _glfw.x11.present.QueryVersion
+#define XPresentSelectInput _glfw.x11.present.SelectInput
+
 typedef VkFlags VkXlibSurfaceCreateFlagsKHR;
 typedef VkFlags VkXcbSurfaceCreateFlagsKHR;
 
@@ -151,6 +199,7 @@ typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR)(Vk
 
 #include "posix_thread.h"
 #include "posix_time.h"
+#include "posix_poll.h"
 #include "xkb_unicode.h"
 #include "glx_context.h"
 #include "egl_context.h"
@@ -174,6 +223,35 @@ typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR)(Vk
 #define _GLFW_PLATFORM_CURSOR_STATE         _GLFWcursorX11  x11
 
 
+// Buffer of an X11 software surface
+//
+typedef struct _GLFWsoftwareBufferX11
+{
+    XImage*         image;
+    // Shared memory segment of the image, if it has one
+    XShmSegmentInfo shm;
+    GLFWbool        shared;
+    // Whether the server may still be reading from the shared memory
+    GLFWbool        busy;
+} _GLFWsoftwareBufferX11;
+
+// Number of swaps in flight whose deadlines are tracked
+#define _GLFW_X11_SWAP_QUEUE_SIZE 4
+
+// Deadline of a swap that has yet to complete
+//
+typedef struct _GLFWswapX11
+{
+    // Present serial the driver sent the swap with
+    uint32_t        serial;
+    GLFWbool        valid;
+    // The MSC the swap was made for, or zero for a plain swap
+    uint64_t        target;
+    // Swap interval and time of a plain swap
+    int             interval;
+    double          time;
+} _GLFWswapX11;
+
 // X11-specific per-window data
 //
 typedef struct _GLFWwindowX11
@@ -197,12 +275,62 @@ typedef struct _GLFWwindowX11
     int             lastCursorPosX, lastCursorPosY;
     // The last position the cursor was warped to by GLFW
     int             warpCursorPosX, warpCursorPosY;
+    // Cursor position served by glfwGetCursorPos without a server round trip,
+    // valid while pointer events for the window keep it up to date
+    GLFWbool        cursorPosValid;
+    int             cursorPosX, cursorPosY;
 
     // The time of the last KeyPress event
     Time            lastKeyTime;
 
+    // Software surface, if the window was created with one
+    struct {
+        GLFWbool    enabled;
+        Visual*     visual;
+        int         depth;
+        GC          gc;
+        int         width, height;
+        _GLFWsoftwareBufferX11 buffers[2];
+        // Index of the buffer the application draws into
+        int         back;
+        // Bounding box of the area the front buffer was last presented with,
+        // which the back buffer has yet to be brought up to date with
+        int         damageX, damageY, damageWidth, damageHeight;
+    } software;
+
+    // Timing of the most recently completed frame, from Present events
+    struct {
+        uint64_t    count;
+        uint64_t    msc;
+        double      time;
+        // Duration of a vblank measured between frames, or zero if unknown
+        double      period;
+        // Vblanks that frames completed after their deadline
+        uint64_t    missed;
+        // SBC of the most recent swap, which DRI3 drivers use as the serial
+        // of the Present request for it
+        uint64_t    sbc;
+        // Swap interval last set for the context of the window
+        int         interval;
+        _GLFWswapX11 swaps[_GLFW_X11_SWAP_QUEUE_SIZE];
+    } frame;
+
 } _GLFWwindowX11;
 
+// Selection data being sent to a requestor in INCR chunks
+//
+typedef struct _GLFWselectionTransferX11
+{
+    Window          requestor;
+    Atom            property;
+    Atom            target;
+    char*           data;
+    size_t          size;
+    size_t          offset;
+    // Timer value in seconds after which an unresponsive requestor is dropped
+    double          deadline;
+} _GLFWselectionTransferX11;
+
 // X11-specific global data
 //
 typedef struct _GLFWlibraryX11
@@ -215,6 +343,8 @@ typedef struct _GLFWlibraryX11
     float           contentScaleX, contentScaleY;
     // Helper window for IPC
     Window          helperWindowHandle;
+    // Pipe written to by glfwPostEmptyEvent to wake up event waits
+    int             emptyEventPipe[2];
     // Invisible cursor for hidden cursor mode
     Cursor          hiddenCursorHandle;
     // Context for mapping window XIDs to _GLFWwindow pointers
@@ -227,6 +357,25 @@ typedef struct _GLFWlibraryX11
     char*           primarySelectionString;
     // Clipboard string (while the selection is owned)
     char*           clipboardString;
+    // INCR transfers of selection data in progress
+    _GLFWselectionTransferX11* transfers;
+    int             transferCount;
+    // Asynchronous clipboard request in progress, if window is not NULL
+    struct {
+        _GLFWwindow*     window;
+        GLFWclipboardfun callback;
+        // Time in seconds the owner may take to respond, and the timer value
+        // in seconds after which the request is abandoned
+        double           timeout;
+        double           deadline;
+        // Index of the target being converted to
+        int              target;
+        // Whether the contents are being received in INCR chunks
+        GLFWbool         incr;
+        char*            data;
+        size_t           size;
+        size_t           capacity;
+    } clipboardRequest;
     // Key name string
     char            keyName[5];
     // X11 keycode to GLFW key LUT
@@ -299,6 +448,10 @@ typedef struct _GLFWlibraryX11
         int         minor;
         GLFWbool    gammaBroken;
         GLFWbool    monitorBroken;
+        // Cached screen resources, or NULL if they have been invalidated
+        XRRScreenResources* resources;
+        // Incremented each time the cached state is invalidated
+        unsigned int invalidations;
         PFN_XRRAllocGamma AllocGamma;
         PFN_XRRFreeCrtcInfo FreeCrtcInfo;
         PFN_XRRFreeGamma FreeGamma;
@@ -399,6 +552,31 @@ typedef struct _GLFWlibraryX11
         PFN_XRenderFindVisualFormat FindVisualFormat;
     } xrender;
 
+    struct {
+        GLFWbool    available;
+        void*       handle;
+        int         eventBase;
+        PFN_XShmQueryExtension QueryExtension;
+        PFN_XShmGetEventBase GetEventBase;
+        PFN_XShmCreateImage CreateImage;
+        PFN_XShmAttach Attach;
+        PFN_XShmDetach Detach;
+        PFN_XShmPutImage PutImage;
+    } shm;
+
+    struct {
+        GLFWbool    available;
+        void*       handle;
+        int         majorOpcode;
+        int         eventBase;
+        int         errorBase;
+        int         major;
+        int         minor;
+        PFN_XPresentQueryExtension QueryExtension;
+        PFN_XPresentQueryVersion QueryVersion;
+        PFN_XPresentSelectInput SelectInput;
+    } present;
+
 } _GLFWlibraryX11;
 
 // X11-specific per-monitor data
@@ -409,6 +587,10 @@ typedef struct _GLFWmonitorX11
     RRCrtc          crtc;
     RRMode          oldMode;
 
+    // Cached CRTC and output info, or NULL if they have been invalidated
+    XRRCrtcInfo*    crtcInfo;
+    XRROutputInfo*  outputInfo;
+
     // Index of corresponding Xinerama screen,
     // for EWMH full screen window placement
     int             index;
@@ -425,6 +607,7 @@ typedef struct _GLFWcursorX11
 
 
 void _glfwPollMonitorsX11(void);
+void _glfwInvalidateMonitorsX11(void);
 void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired);
 void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor);
 
@@ -440,5 +623,6 @@ void _glfwGrabErrorHandlerX11(void);
 void _glfwReleaseErrorHandlerX11(void);
 void _glfwInputErrorX11(int error, const char* message);
 
+void _glfwQueueSwapX11(_GLFWwindow* window, uint64_t sbc, uint64_t target, int interval);
 void _glfwPushSelectionToManagerX11(void);
 
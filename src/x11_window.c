@@ -30,7 +30,10 @@
 #include <X11/cursorfont.h>
 #include <X11/Xmd.h>
 
-#include <sys/select.h>
+#include <poll.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <time.h>
 
 #include <string.h>
 #include <stdio.h>
@@ -50,51 +53,43 @@
 
 #define _GLFW_XDND_VERSION 5
 
+// Largest amount of selection data written in a single request, and how long
+// a requestor may take to ask for the next chunk of an INCR transfer
+#define _GLFW_SELECTION_CHUNK_SIZE (256 * 1024)
+#define _GLFW_SELECTION_TIMEOUT 30.0
 
-// Wait for data to arrive using select
+// How long to wait for the server to report that it has finished reading
+// a software surface buffer before making sure with a round trip
+#define _GLFW_SHM_COMPLETION_TIMEOUT 0.5
+
+
+// Wait for data to arrive on the X connection
 // This avoids blocking other threads via the per-display Xlib lock that also
 // covers GLX functions
 //
 static GLFWbool waitForEvent(double* timeout)
 {
-    fd_set fds;
-    const int fd = ConnectionNumber(_glfw.x11.display);
-    int count = fd + 1;
-
-#if defined(__linux__)
-    if (_glfw.linjs.inotify > fd)
-        count = _glfw.linjs.inotify + 1;
-#endif
-    for (;;)
-    {
-        FD_ZERO(&fds);
-        FD_SET(fd, &fds);
-#if defined(__linux__)
-        if (_glfw.linjs.inotify > 0)
-            FD_SET(_glfw.linjs.inotify, &fds);
-#endif
-
-        if (timeout)
-        {
-            const long seconds = (long) *timeout;
-            const long microseconds = (long) ((*timeout - seconds) * 1e6);
-            struct timeval tv = { seconds, microseconds };
-            const uint64_t base = _glfwPlatformGetTimerValue();
+    struct pollfd fd = { ConnectionNumber(_glfw.x11.display), POLLIN };
+    return _glfwPollPOSIX(&fd, 1, timeout);
+}
 
-            const int result = select(count, &fds, NULL, NULL, &tv);
-            const int error = errno;
+// Wait for an X event to be pending or for any event source to be dispatched
+//
+static GLFWbool waitForAnyEvent(double* timeout)
+{
+    struct pollfd fd = { ConnectionNumber(_glfw.x11.display), POLLIN };
 
-            *timeout -= (_glfwPlatformGetTimerValue() - base) /
-                (double) _glfwPlatformGetTimerFrequency();
+    while (!XPending(_glfw.x11.display))
+    {
+        if (!_glfwWaitEventsPOSIX(&fd, 1, timeout))
+            return GLFW_FALSE;
 
-            if (result > 0)
-                return GLFW_TRUE;
-            if ((result == -1 && error == EINTR) || *timeout <= 0.0)
-                return GLFW_FALSE;
-        }
-        else if (select(count, &fds, NULL, NULL, NULL) != -1 || errno != EINTR)
+        // Only event sources were ready and their callbacks have been called
+        if (!(fd.revents & POLLIN))
             return GLFW_TRUE;
     }
+
+    return GLFW_TRUE;
 }
 
 // Waits until a VisibilityNotify event arrives for the specified window or the
@@ -145,6 +140,24 @@ static int getWindowState(_GLFWwindow* window)
 //
 static Bool isSelectionEvent(Display* display, XEvent* event, XPointer pointer)
 {
+    // Requestors of INCR transfers may be waiting for their remaining chunks
+    if (event->type == PropertyNotify &&
+        event->xproperty.state == PropertyDelete)
+    {
+        int i;
+
+        for (i = 0;  i < _glfw.x11.transferCount;  i++)
+        {
+            if (_glfw.x11.transfers[i].requestor == event->xproperty.window &&
+                _glfw.x11.transfers[i].property == event->xproperty.atom)
+            {
+                return True;
+            }
+        }
+
+        return False;
+    }
+
     if (event->xany.window != _glfw.x11.helperWindowHandle)
         return False;
 
@@ -550,6 +563,25 @@ static void centerCursor(_GLFWwindow* window)
     _glfwPlatformSetCursorPos(window, width / 2.0, height / 2.0);
 }
 
+// Retrieves the cursor position from the server and updates the cache
+//
+static void queryCursorPos(_GLFWwindow* window)
+{
+    Window root, child;
+    int rootX, rootY, childX, childY;
+    unsigned int mask;
+
+    XQueryPointer(_glfw.x11.display, window->x11.handle,
+                  &root, &child,
+                  &rootX, &rootY, &childX, &childY,
+                  &mask);
+
+    // Only pointer events for the window can tell whether it will receive
+    // motion events, as another window may be on top of it
+    window->x11.cursorPosX = childX;
+    window->x11.cursorPosY = childY;
+}
+
 // Updates the cursor image according to its cursor mode
 //
 static void updateCursorImage(_GLFWwindow* window)
@@ -765,6 +797,228 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
     return GLFW_TRUE;
 }
 
+// Returns the timer value in seconds
+//
+static double getTimerSeconds(void)
+{
+    return (double) _glfwPlatformGetTimerValue() /
+        _glfwPlatformGetTimerFrequency();
+}
+
+// Returns the largest amount of selection data to write in a single request
+//
+static size_t getSelectionChunkSize(void)
+{
+    long size = XExtendedMaxRequestSize(_glfw.x11.display);
+    if (!size)
+        size = XMaxRequestSize(_glfw.x11.display);
+
+    // The maximum is in four byte units and includes the request header
+    size = size * 4 - 256;
+
+    if (size > _GLFW_SELECTION_CHUNK_SIZE)
+        return _GLFW_SELECTION_CHUNK_SIZE;
+
+    return (size_t) size;
+}
+
+// Removes the specified INCR transfer
+//
+static void removeSelectionTransfer(int index)
+{
+    free(_glfw.x11.transfers[index].data);
+
+    _glfw.x11.transferCount--;
+    _glfw.x11.transfers[index] = _glfw.x11.transfers[_glfw.x11.transferCount];
+}
+
+// Starts sending selection data too large for a single request in INCR chunks
+// (ICCCM section 2.7.2)
+//
+static GLFWbool startSelectionTransfer(Window requestor, Atom property,
+                                       Atom target, const char* data,
+                                       size_t size)
+{
+    const long incrSize = (long) size;
+    _GLFWselectionTransferX11* transfers;
+    _GLFWselectionTransferX11* transfer;
+
+    transfers = realloc(_glfw.x11.transfers,
+                        (_glfw.x11.transferCount + 1) *
+                        sizeof(_GLFWselectionTransferX11));
+    if (!transfers)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    _glfw.x11.transfers = transfers;
+
+    transfer = transfers + _glfw.x11.transferCount;
+    transfer->data = malloc(size);
+    if (!transfer->data)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    // The data is copied as the selection may change during the transfer
+    memcpy(transfer->data, data, size);
+    transfer->requestor = requestor;
+    transfer->property = property;
+    transfer->target = target;
+    transfer->size = size;
+    transfer->offset = 0;
+    transfer->deadline = getTimerSeconds() + _GLFW_SELECTION_TIMEOUT;
+    _glfw.x11.transferCount++;
+
+    // The requestor is a foreign window that may be destroyed at any time
+    _glfwGrabErrorHandlerX11();
+
+    // Each chunk is requested by deleting the property, but the event mask of
+    // windows created by GLFW must not be replaced and already includes this
+    if (requestor != _glfw.x11.helperWindowHandle &&
+        !findWindowByHandle(requestor))
+    {
+        XSelectInput(_glfw.x11.display, requestor, PropertyChangeMask);
+    }
+
+    XChangeProperty(_glfw.x11.display,
+                    requestor,
+                    property,
+                    _glfw.x11.INCR,
+                    32,
+                    PropModeReplace,
+                    (unsigned char*) &incrSize,
+                    1);
+
+    _glfwReleaseErrorHandlerX11();
+
+    if (_glfw.x11.errorCode != Success)
+    {
+        removeSelectionTransfer(_glfw.x11.transferCount - 1);
+        return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Sends the next chunk of the INCR transfer whose property was deleted, if any
+//
+static GLFWbool handleSelectionTransfer(const XEvent* event)
+{
+    int i;
+    size_t size;
+    _GLFWselectionTransferX11* transfer;
+
+    if (event->xproperty.state != PropertyDelete)
+        return GLFW_FALSE;
+
+    for (i = 0;  i < _glfw.x11.transferCount;  i++)
+    {
+        transfer = _glfw.x11.transfers + i;
+        if (transfer->requestor == event->xproperty.window &&
+            transfer->property == event->xproperty.atom)
+        {
+            break;
+        }
+    }
+
+    if (i == _glfw.x11.transferCount)
+        return GLFW_FALSE;
+
+    size = transfer->size - transfer->offset;
+    if (size > getSelectionChunkSize())
+        size = getSelectionChunkSize();
+
+    _glfwGrabErrorHandlerX11();
+
+    // A zero-length chunk tells the requestor the transfer is complete
+    XChangeProperty(_glfw.x11.display,
+                    transfer->requestor,
+                    transfer->property,
+                    transfer->target,
+                    8,
+                    PropModeReplace,
+                    (unsigned char*) transfer->data + transfer->offset,
+                    size);
+
+    _glfwReleaseErrorHandlerX11();
+
+    if (_glfw.x11.errorCode != Success)
+    {
+        // The requestor window is gone, so its event mask is left alone
+        removeSelectionTransfer(i);
+        return GLFW_TRUE;
+    }
+
+    transfer->offset += size;
+    transfer->deadline = getTimerSeconds() + _GLFW_SELECTION_TIMEOUT;
+
+    if (!size)
+    {
+        const Window requestor = transfer->requestor;
+        int j;
+
+        removeSelectionTransfer(i);
+
+        for (j = 0;  j < _glfw.x11.transferCount;  j++)
+        {
+            if (_glfw.x11.transfers[j].requestor == requestor)
+                break;
+        }
+
+        if (j == _glfw.x11.transferCount &&
+            requestor != _glfw.x11.helperWindowHandle &&
+            !findWindowByHandle(requestor))
+        {
+            _glfwGrabErrorHandlerX11();
+            XSelectInput(_glfw.x11.display, requestor, NoEventMask);
+            _glfwReleaseErrorHandlerX11();
+        }
+    }
+
+    return GLFW_TRUE;
+}
+
+// Drops INCR transfers whose requestor has stopped asking for chunks
+//
+static void pruneSelectionTransfers(void)
+{
+    int i;
+    const double now = getTimerSeconds();
+
+    // The requestor window may be gone, so its event mask is left alone
+    for (i = _glfw.x11.transferCount - 1;  i >= 0;  i--)
+    {
+        if (_glfw.x11.transfers[i].deadline <= now)
+            removeSelectionTransfer(i);
+    }
+}
+
+// Writes the selection string to the specified property, sending it in INCR
+// chunks if it is too large for a single request
+//
+static GLFWbool writeSelectionString(Window requestor, Atom property,
+                                     Atom target, const char* string)
+{
+    const size_t size = strlen(string);
+
+    if (size > getSelectionChunkSize())
+        return startSelectionTransfer(requestor, property, target, string, size);
+
+    XChangeProperty(_glfw.x11.display,
+                    requestor,
+                    property,
+                    target,
+                    8,
+                    PropModeReplace,
+                    (unsigned char*) string,
+                    size);
+
+    return GLFW_TRUE;
+}
+
 // Set the specified property to the selection converted to the requested target
 //
 static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
@@ -829,19 +1083,14 @@ static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
                     break;
             }
 
-            if (j < formatCount)
+            if (j == formatCount ||
+                !writeSelectionString(request->requestor,
+                                      targets[i + 1],
+                                      targets[i],
+                                      selectionString))
             {
-                XChangeProperty(_glfw.x11.display,
-                                request->requestor,
-                                targets[i + 1],
-                                targets[i],
-                                8,
-                                PropModeReplace,
-                                (unsigned char *) selectionString,
-                                strlen(selectionString));
-            }
-            else
                 targets[i + 1] = None;
+            }
         }
 
         XChangeProperty(_glfw.x11.display,
@@ -883,14 +1132,13 @@ static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
         {
             // The requested target is one we support
 
-            XChangeProperty(_glfw.x11.display,
-                            request->requestor,
-                            request->property,
-                            request->target,
-                            8,
-                            PropModeReplace,
-                            (unsigned char *) selectionString,
-                            strlen(selectionString));
+            if (!writeSelectionString(request->requestor,
+                                      request->property,
+                                      request->target,
+                                      selectionString))
+            {
+                return None;
+            }
 
             return request->property;
         }
@@ -933,6 +1181,216 @@ static void handleSelectionRequest(XEvent* event)
     XSendEvent(_glfw.x11.display, request->requestor, False, 0, &reply);
 }
 
+// Returns the time left before the clipboard request times out
+//
+static double getClipboardRequestTimeLeft(void)
+{
+    const double left = _glfw.x11.clipboardRequest.deadline - getTimerSeconds();
+    return left > 0.0 ? left : 0.0;
+}
+
+// Asks the clipboard owner to convert its contents to the current target of
+// the clipboard request
+//
+static void convertClipboardRequest(void)
+{
+    const Atom targets[] = { _glfw.x11.UTF8_STRING, XA_STRING };
+
+    XConvertSelection(_glfw.x11.display,
+                      _glfw.x11.CLIPBOARD,
+                      targets[_glfw.x11.clipboardRequest.target],
+                      _glfw.x11.GLFW_SELECTION,
+                      _glfw.x11.helperWindowHandle,
+                      CurrentTime);
+    XFlush(_glfw.x11.display);
+}
+
+// Ends the clipboard request and passes the result to its callback
+//
+static void finishClipboardRequest(char* string)
+{
+    _GLFWwindow* window = _glfw.x11.clipboardRequest.window;
+    const GLFWclipboardfun callback = _glfw.x11.clipboardRequest.callback;
+
+    free(_glfw.x11.clipboardRequest.data);
+    memset(&_glfw.x11.clipboardRequest, 0, sizeof(_glfw.x11.clipboardRequest));
+
+    callback((GLFWwindow*) window, string);
+    free(string);
+}
+
+// Handles the reply of the clipboard owner to a clipboard request conversion
+//
+static void handleSelectionNotify(XEvent* event)
+{
+    const Atom targets[] = { _glfw.x11.UTF8_STRING, XA_STRING };
+    const int targetCount = sizeof(targets) / sizeof(targets[0]);
+    const int target = _glfw.x11.clipboardRequest.target;
+
+    if (!_glfw.x11.clipboardRequest.window || _glfw.x11.clipboardRequest.incr)
+        return;
+
+    if (event->xselection.selection != _glfw.x11.CLIPBOARD ||
+        event->xselection.target != targets[target])
+    {
+        return;
+    }
+
+    if (event->xselection.property != None)
+    {
+        char* data;
+        Atom actualType;
+        int actualFormat;
+        unsigned long itemCount, bytesAfter;
+
+        XGetWindowProperty(_glfw.x11.display,
+                           event->xselection.requestor,
+                           event->xselection.property,
+                           0,
+                           LONG_MAX,
+                           True,
+                           AnyPropertyType,
+                           &actualType,
+                           &actualFormat,
+                           &itemCount,
+                           &bytesAfter,
+                           (unsigned char**) &data);
+
+        if (actualType == _glfw.x11.INCR)
+        {
+            // Deleting the property told the owner to start sending chunks
+            _glfw.x11.clipboardRequest.incr = GLFW_TRUE;
+            _glfw.x11.clipboardRequest.deadline =
+                getTimerSeconds() + _glfw.x11.clipboardRequest.timeout;
+
+            XFree(data);
+            return;
+        }
+
+        if (actualType == targets[target])
+        {
+            char* string;
+
+            if (actualType == XA_STRING)
+                string = convertLatin1toUTF8(data);
+            else
+                string = _glfw_strdup(data);
+
+            XFree(data);
+            finishClipboardRequest(string);
+            return;
+        }
+
+        if (data)
+            XFree(data);
+    }
+
+    if (target + 1 < targetCount)
+    {
+        _glfw.x11.clipboardRequest.target++;
+        convertClipboardRequest();
+        return;
+    }
+
+    _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                    "X11: Failed to convert selection to string");
+    finishClipboardRequest(NULL);
+}
+
+// Receives a chunk of an INCR transfer for the clipboard request
+//
+static void handleClipboardChunk(XEvent* event)
+{
+    const Atom targets[] = { _glfw.x11.UTF8_STRING, XA_STRING };
+    char* data;
+    Atom actualType;
+    int actualFormat;
+    unsigned long itemCount, bytesAfter;
+
+    if (!_glfw.x11.clipboardRequest.window || !_glfw.x11.clipboardRequest.incr)
+        return;
+
+    if (event->xproperty.state != PropertyNewValue ||
+        event->xproperty.atom != _glfw.x11.GLFW_SELECTION)
+    {
+        return;
+    }
+
+    XGetWindowProperty(_glfw.x11.display,
+                       _glfw.x11.helperWindowHandle,
+                       _glfw.x11.GLFW_SELECTION,
+                       0,
+                       LONG_MAX,
+                       True,
+                       AnyPropertyType,
+                       &actualType,
+                       &actualFormat,
+                       &itemCount,
+                       &bytesAfter,
+                       (unsigned char**) &data);
+
+    if (itemCount)
+    {
+        const size_t size = _glfw.x11.clipboardRequest.size + itemCount;
+
+        if (size + 1 > _glfw.x11.clipboardRequest.capacity)
+        {
+            char* buffer;
+            size_t capacity = _glfw.x11.clipboardRequest.capacity;
+
+            if (!capacity)
+                capacity = 4096;
+            while (capacity < size + 1)
+                capacity *= 2;
+
+            buffer = realloc(_glfw.x11.clipboardRequest.data, capacity);
+            if (!buffer)
+            {
+                XFree(data);
+                _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                finishClipboardRequest(NULL);
+                return;
+            }
+
+            _glfw.x11.clipboardRequest.data = buffer;
+            _glfw.x11.clipboardRequest.capacity = capacity;
+        }
+
+        memcpy(_glfw.x11.clipboardRequest.data + _glfw.x11.clipboardRequest.size,
+               data, itemCount);
+        _glfw.x11.clipboardRequest.data[size] = '\0';
+        _glfw.x11.clipboardRequest.size = size;
+
+        // The owner is still responding, so give it another full timeout
+        _glfw.x11.clipboardRequest.deadline =
+            getTimerSeconds() + _glfw.x11.clipboardRequest.timeout;
+
+        XFree(data);
+        return;
+    }
+
+    if (data)
+        XFree(data);
+
+    // A zero-length chunk ends the transfer
+    {
+        char* string = _glfw.x11.clipboardRequest.data;
+        _glfw.x11.clipboardRequest.data = NULL;
+
+        if (!string)
+            string = _glfw_strdup("");
+
+        if (targets[_glfw.x11.clipboardRequest.target] == XA_STRING)
+        {
+            char* converted = convertLatin1toUTF8(string);
+            free(string);
+            string = converted;
+        }
+
+        finishClipboardRequest(string);
+    }
+}
+
 static const char* getSelectionString(Atom selection)
 {
     size_t i;
@@ -953,6 +1411,10 @@ static const char* getSelectionString(Atom selection)
         return *selectionString;
     }
 
+    // The conversions below would consume the replies to the request
+    if (_glfw.x11.clipboardRequest.window)
+        finishClipboardRequest(NULL);
+
     free(*selectionString);
     *selectionString = NULL;
 
@@ -1061,79 +1523,484 @@ static const char* getSelectionString(Atom selection)
 
         XFree(data);
 
-        if (*selectionString)
-            break;
+        if (*selectionString)
+            break;
+    }
+
+    if (!*selectionString)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "X11: Failed to convert selection to string");
+    }
+
+    return *selectionString;
+}
+
+// Make the specified window and its video mode active on its monitor
+//
+static void acquireMonitor(_GLFWwindow* window)
+{
+    if (_glfw.x11.saver.count == 0)
+    {
+        // Remember old screen saver settings
+        XGetScreenSaver(_glfw.x11.display,
+                        &_glfw.x11.saver.timeout,
+                        &_glfw.x11.saver.interval,
+                        &_glfw.x11.saver.blanking,
+                        &_glfw.x11.saver.exposure);
+
+        // Disable screen saver
+        XSetScreenSaver(_glfw.x11.display, 0, 0, DontPreferBlanking,
+                        DefaultExposures);
+    }
+
+    if (!window->monitor->window)
+        _glfw.x11.saver.count++;
+
+    _glfwSetVideoModeX11(window->monitor, &window->videoMode);
+
+    if (window->x11.overrideRedirect)
+    {
+        int xpos, ypos;
+        GLFWvidmode mode;
+
+        // Manually position the window over its monitor
+        _glfwPlatformGetMonitorPos(window->monitor, &xpos, &ypos);
+        _glfwPlatformGetVideoMode(window->monitor, &mode);
+
+        XMoveResizeWindow(_glfw.x11.display, window->x11.handle,
+                          xpos, ypos, mode.width, mode.height);
+    }
+
+    _glfwInputMonitorWindow(window->monitor, window);
+}
+
+// Remove the window and restore the original video mode
+//
+static void releaseMonitor(_GLFWwindow* window)
+{
+    if (window->monitor->window != window)
+        return;
+
+    _glfwInputMonitorWindow(window->monitor, NULL);
+    _glfwRestoreVideoModeX11(window->monitor);
+
+    _glfw.x11.saver.count--;
+
+    if (_glfw.x11.saver.count == 0)
+    {
+        // Restore old screen saver settings
+        XSetScreenSaver(_glfw.x11.display,
+                        _glfw.x11.saver.timeout,
+                        _glfw.x11.saver.interval,
+                        _glfw.x11.saver.blanking,
+                        _glfw.x11.saver.exposure);
+    }
+}
+
+// Returns the byte order of the host, for images in client memory
+//
+static int getHostByteOrder(void)
+{
+    const int one = 1;
+    return *((const char*) &one) ? LSBFirst : MSBFirst;
+}
+
+// Creates the software surface of the specified window
+//
+static GLFWbool createSoftwareSurface(_GLFWwindow* window,
+                                      Visual* visual, int depth)
+{
+    int i, count;
+    GLFWbool found = GLFW_FALSE;
+    XPixmapFormatValues* formats;
+
+    // Pixels are exposed to the application as 32-bit 0x00RRGGBB values
+    if (visual->class != TrueColor || (depth != 24 && depth != 32) ||
+        visual->red_mask != 0xff0000 ||
+        visual->green_mask != 0xff00 ||
+        visual->blue_mask != 0xff)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "X11: Visual is unsuitable for a software surface");
+        return GLFW_FALSE;
+    }
+
+    formats = XListPixmapFormats(_glfw.x11.display, &count);
+    for (i = 0;  i < count;  i++)
+    {
+        if (formats[i].depth == depth && formats[i].bits_per_pixel == 32)
+            found = GLFW_TRUE;
+    }
+
+    if (formats)
+        XFree(formats);
+
+    if (!found)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "X11: Server has no 32-bit pixel format for a software surface");
+        return GLFW_FALSE;
+    }
+
+    window->x11.software.gc = XCreateGC(_glfw.x11.display,
+                                        window->x11.handle,
+                                        0, NULL);
+    window->x11.software.visual = visual;
+    window->x11.software.depth = depth;
+    window->x11.software.enabled = GLFW_TRUE;
+    return GLFW_TRUE;
+}
+
+// Creates a software surface buffer, in memory shared with the server if
+// possible
+//
+static GLFWbool createSoftwareBuffer(_GLFWwindow* window,
+                                     _GLFWsoftwareBufferX11* buffer,
+                                     int width, int height)
+{
+    memset(buffer, 0, sizeof(_GLFWsoftwareBufferX11));
+
+    if (_glfw.x11.shm.available)
+    {
+        buffer->image = XShmCreateImage(_glfw.x11.display,
+                                        window->x11.software.visual,
+                                        window->x11.software.depth,
+                                        ZPixmap, NULL, &buffer->shm,
+                                        width, height);
+        if (buffer->image)
+        {
+            buffer->shm.shmid = shmget(IPC_PRIVATE,
+                                       buffer->image->bytes_per_line * height,
+                                       IPC_CREAT | 0600);
+            if (buffer->shm.shmid != -1)
+            {
+                buffer->shm.shmaddr = shmat(buffer->shm.shmid, NULL, 0);
+                buffer->shm.readOnly = False;
+
+                if (buffer->shm.shmaddr != (char*) -1)
+                {
+                    _glfwGrabErrorHandlerX11();
+                    XShmAttach(_glfw.x11.display, &buffer->shm);
+                    _glfwReleaseErrorHandlerX11();
+
+                    // The segment is freed once both sides have detached
+                    shmctl(buffer->shm.shmid, IPC_RMID, NULL);
+
+                    if (_glfw.x11.errorCode == Success)
+                    {
+                        buffer->image->data = buffer->shm.shmaddr;
+                        buffer->shared = GLFW_TRUE;
+                        return GLFW_TRUE;
+                    }
+
+                    shmdt(buffer->shm.shmaddr);
+
+                    // The server cannot attach segments of clients on other
+                    // hosts, so fall back to XPutImage from here on
+                    _glfw.x11.shm.available = GLFW_FALSE;
+                }
+                else
+                    shmctl(buffer->shm.shmid, IPC_RMID, NULL);
+            }
+
+            XDestroyImage(buffer->image);
+            buffer->image = NULL;
+        }
+    }
+
+    buffer->image = XCreateImage(_glfw.x11.display,
+                                 window->x11.software.visual,
+                                 window->x11.software.depth,
+                                 ZPixmap, 0, NULL, width, height, 32, 0);
+    if (!buffer->image)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Failed to create software surface buffer");
+        return GLFW_FALSE;
+    }
+
+    buffer->image->data = calloc(buffer->image->bytes_per_line, height);
+    if (!buffer->image->data)
+    {
+        XDestroyImage(buffer->image);
+        buffer->image = NULL;
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    // Xlib swaps the pixels if the server uses another byte order
+    buffer->image->byte_order = getHostByteOrder();
+    return GLFW_TRUE;
+}
+
+// Destroys a software surface buffer
+//
+static void destroySoftwareBuffer(_GLFWsoftwareBufferX11* buffer)
+{
+    if (!buffer->image)
+        return;
+
+    if (buffer->shared)
+    {
+        // The server finishes any pending XShmPutImage before the detach
+        XShmDetach(_glfw.x11.display, &buffer->shm);
+        shmdt(buffer->shm.shmaddr);
+        buffer->image->data = NULL;
+    }
+
+    XDestroyImage(buffer->image);
+    memset(buffer, 0, sizeof(_GLFWsoftwareBufferX11));
+}
+
+// Destroys both buffers of the software surface of the specified window
+//
+static void destroySoftwareBuffers(_GLFWwindow* window)
+{
+    destroySoftwareBuffer(window->x11.software.buffers + 0);
+    destroySoftwareBuffer(window->x11.software.buffers + 1);
+    window->x11.software.width = 0;
+    window->x11.software.height = 0;
+}
+
+// Marks the buffer named by a ShmCompletion event as no longer in use
+//
+static void handleShmCompletion(const XEvent* event)
+{
+    const XShmCompletionEvent* completion = (const XShmCompletionEvent*) event;
+    _GLFWwindow* window = findWindowByHandle(completion->drawable);
+    int i;
+
+    if (!window)
+        return;
+
+    for (i = 0;  i < 2;  i++)
+    {
+        _GLFWsoftwareBufferX11* buffer = window->x11.software.buffers + i;
+        if (buffer->shared && buffer->shm.shmseg == completion->shmseg)
+            buffer->busy = GLFW_FALSE;
+    }
+}
+
+// Clips the specified x, y, width, height rectangle to the software surface
+// and returns whether anything of it remains
+//
+static GLFWbool getSoftwareRect(_GLFWwindow* window,
+                                const int* rect, int* area)
+{
+    const int width = window->x11.software.width;
+    const int height = window->x11.software.height;
+    int x0, y0, x1, y1;
+
+    if (rect[2] <= 0 || rect[3] <= 0 ||
+        rect[0] >= width || rect[1] >= height)
+    {
+        return GLFW_FALSE;
+    }
+
+    x0 = rect[0] > 0 ? rect[0] : 0;
+    y0 = rect[1] > 0 ? rect[1] : 0;
+    x1 = rect[2] < width - rect[0] ? rect[0] + rect[2] : width;
+    y1 = rect[3] < height - rect[1] ? rect[1] + rect[3] : height;
+
+    if (x0 >= x1 || y0 >= y1)
+        return GLFW_FALSE;
+
+    if (area)
+    {
+        area[0] = x0;
+        area[1] = y0;
+        area[2] = x1 - x0;
+        area[3] = y1 - y0;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Makes the back buffer of the software surface ready for drawing, waiting for
+// the server to finish reading it and bringing it up to date with the front
+//
+static GLFWbool acquireSoftwareBuffer(_GLFWwindow* window)
+{
+    _GLFWsoftwareBufferX11* back;
+    const _GLFWsoftwareBufferX11* front;
+    int y;
+
+    if (window->x11.software.width != window->x11.width ||
+        window->x11.software.height != window->x11.height)
+    {
+        destroySoftwareBuffers(window);
+
+        if (!createSoftwareBuffer(window, window->x11.software.buffers + 0,
+                                  window->x11.width, window->x11.height) ||
+            !createSoftwareBuffer(window, window->x11.software.buffers + 1,
+                                  window->x11.width, window->x11.height))
+        {
+            destroySoftwareBuffers(window);
+            return GLFW_FALSE;
+        }
+
+        window->x11.software.width = window->x11.width;
+        window->x11.software.height = window->x11.height;
+        window->x11.software.back = 0;
+        window->x11.software.damageWidth = 0;
+        window->x11.software.damageHeight = 0;
+        return GLFW_TRUE;
+    }
+
+    back = window->x11.software.buffers + window->x11.software.back;
+    front = window->x11.software.buffers + !window->x11.software.back;
+
+    if (back->busy)
+    {
+        XEvent event;
+        double timeout = _GLFW_SHM_COMPLETION_TIMEOUT;
+
+        XFlush(_glfw.x11.display);
+
+        while (back->busy)
+        {
+            if (XCheckTypedEvent(_glfw.x11.display,
+                                 _glfw.x11.shm.eventBase + ShmCompletion,
+                                 &event))
+            {
+                handleShmCompletion(&event);
+            }
+            else if (!waitForEvent(&timeout))
+            {
+                // No completion arrives for a put the server rejected, but
+                // once the server has processed it the buffer is no longer
+                // read from either way
+                XSync(_glfw.x11.display, False);
+
+                while (XCheckTypedEvent(_glfw.x11.display,
+                                        _glfw.x11.shm.eventBase + ShmCompletion,
+                                        &event))
+                {
+                    handleShmCompletion(&event);
+                }
+
+                back->busy = GLFW_FALSE;
+            }
+        }
     }
 
-    if (!*selectionString)
+    if (window->x11.software.damageWidth && window->x11.software.damageHeight)
     {
-        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
-                        "X11: Failed to convert selection to string");
+        const int stride = back->image->bytes_per_line;
+        const int offset = window->x11.software.damageX * 4;
+        const int size = window->x11.software.damageWidth * 4;
+
+        for (y = window->x11.software.damageY;
+             y < window->x11.software.damageY + window->x11.software.damageHeight;
+             y++)
+        {
+            memcpy(back->image->data + y * stride + offset,
+                   front->image->data + y * stride + offset,
+                   size);
+        }
+
+        window->x11.software.damageWidth = 0;
+        window->x11.software.damageHeight = 0;
     }
 
-    return *selectionString;
+    return GLFW_TRUE;
 }
 
-// Make the specified window and its video mode active on its monitor
+// Converts a Present timestamp to the time base of glfwGetTime
 //
-static void acquireMonitor(_GLFWwindow* window)
+static double ustToTimerTime(uint64_t ust)
 {
-    if (_glfw.x11.saver.count == 0)
-    {
-        // Remember old screen saver settings
-        XGetScreenSaver(_glfw.x11.display,
-                        &_glfw.x11.saver.timeout,
-                        &_glfw.x11.saver.interval,
-                        &_glfw.x11.saver.blanking,
-                        &_glfw.x11.saver.exposure);
+    struct timespec now;
+    double age;
 
-        // Disable screen saver
-        XSetScreenSaver(_glfw.x11.display, 0, 0, DontPreferBlanking,
-                        DefaultExposures);
+    // Present timestamps are microseconds of the monotonic clock
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    age = (double) ((int64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000 -
+                    (int64_t) ust) / 1e6;
+
+    return (double) (_glfwPlatformGetTimerValue() - _glfw.timer.offset) /
+        _glfwPlatformGetTimerFrequency() - age;
+}
+
+// Retrieves the MSC the specified swap had to reach the screen by, if known
+//
+static GLFWbool getSwapDeadline(_GLFWwindow* window, const _GLFWswapX11* swap,
+                                uint64_t* deadline)
+{
+    if (swap->target)
+    {
+        *deadline = swap->target;
+        return GLFW_TRUE;
     }
 
-    if (!window->monitor->window)
-        _glfw.x11.saver.count++;
+    if (!window->x11.frame.count)
+        return GLFW_FALSE;
 
-    _glfwSetVideoModeX11(window->monitor, &window->videoMode);
+    *deadline = window->x11.frame.msc + swap->interval;
 
-    if (window->x11.overrideRedirect)
+    // A plain swap made after the previous frame reached the screen cannot
+    // make any vblank before the one following the swap
+    if (swap->time > window->x11.frame.time)
     {
-        int xpos, ypos;
-        GLFWvidmode mode;
+        uint64_t first;
 
-        // Manually position the window over its monitor
-        _glfwPlatformGetMonitorPos(window->monitor, &xpos, &ypos);
-        _glfwPlatformGetVideoMode(window->monitor, &mode);
+        if (window->x11.frame.period <= 0.0)
+            return GLFW_FALSE;
 
-        XMoveResizeWindow(_glfw.x11.display, window->x11.handle,
-                          xpos, ypos, mode.width, mode.height);
+        first = window->x11.frame.msc + 1 +
+            (uint64_t) ((swap->time - window->x11.frame.time) /
+                        window->x11.frame.period);
+        if (first > *deadline)
+            *deadline = first;
     }
 
-    _glfwInputMonitorWindow(window->monitor, window);
+    return GLFW_TRUE;
 }
 
-// Remove the window and restore the original video mode
+// Records the timing of a frame that has reached the screen
 //
-static void releaseMonitor(_GLFWwindow* window)
+static void handlePresentComplete(const XPresentCompleteNotifyEvent* event)
 {
-    if (window->monitor->window != window)
+    uint64_t deadline;
+    double time;
+    _GLFWswapX11* swap;
+    _GLFWwindow* window = findWindowByHandle(event->window);
+    if (!window)
         return;
 
-    _glfwInputMonitorWindow(window->monitor, NULL);
-    _glfwRestoreVideoModeX11(window->monitor);
+    // Completed MSC waits are not swaps
+    if (event->kind != PresentCompleteKindPixmap)
+        return;
 
-    _glfw.x11.saver.count--;
+    swap = window->x11.frame.swaps +
+        event->serial_number % _GLFW_X11_SWAP_QUEUE_SIZE;
+    if (swap->valid && swap->serial == event->serial_number)
+        swap->valid = GLFW_FALSE;
+    else
+        swap = NULL;
 
-    if (_glfw.x11.saver.count == 0)
+    // Skipped frames put nothing on the screen
+    if (event->mode == PresentCompleteModeSkip)
+        return;
+
+    if (swap && getSwapDeadline(window, swap, &deadline) &&
+        event->msc > deadline)
     {
-        // Restore old screen saver settings
-        XSetScreenSaver(_glfw.x11.display,
-                        _glfw.x11.saver.timeout,
-                        _glfw.x11.saver.interval,
-                        _glfw.x11.saver.blanking,
-                        _glfw.x11.saver.exposure);
+        window->x11.frame.missed += event->msc - deadline;
+    }
+
+    time = ustToTimerTime(event->ust);
+
+    if (window->x11.frame.count && event->msc > window->x11.frame.msc)
+    {
+        window->x11.frame.period = (time - window->x11.frame.time) /
+            (double) (event->msc - window->x11.frame.msc);
     }
+
+    window->x11.frame.msc = event->msc;
+    window->x11.frame.time = time;
+    window->x11.frame.count++;
 }
 
 // Process the specified X event
@@ -1151,18 +2018,53 @@ static void processEvent(XEvent *event)
     if (_glfw.x11.im)
         filtered = XFilterEvent(event, None);
 
+    if (_glfw.x11.shm.eventBase &&
+        event->type == _glfw.x11.shm.eventBase + ShmCompletion)
+    {
+        handleShmCompletion(event);
+        return;
+    }
+
     if (_glfw.x11.randr.available)
     {
+        if (event->type == _glfw.x11.randr.eventBase + RRScreenChangeNotify)
+        {
+            XRRUpdateConfiguration(event);
+            _glfwInvalidateMonitorsX11();
+            return;
+        }
+
         if (event->type == _glfw.x11.randr.eventBase + RRNotify)
         {
+            const XRRNotifyEvent* notify = (XRRNotifyEvent*) event;
+
             XRRUpdateConfiguration(event);
-            _glfwPollMonitorsX11();
+            _glfwInvalidateMonitorsX11();
+
+            // Only output changes can connect or disconnect monitors
+            if (notify->subtype == RRNotify_OutputChange)
+                _glfwPollMonitorsX11();
+
             return;
         }
     }
 
     if (event->type == GenericEvent)
     {
+        if (_glfw.x11.present.available &&
+            event->xcookie.extension == _glfw.x11.present.majorOpcode)
+        {
+            if (XGetEventData(_glfw.x11.display, &event->xcookie))
+            {
+                if (event->xcookie.evtype == PresentCompleteNotify)
+                    handlePresentComplete(event->xcookie.data);
+
+                XFreeEventData(_glfw.x11.display, &event->xcookie);
+            }
+
+            return;
+        }
+
         if (_glfw.x11.xi.available)
         {
             _GLFWwindow* window = _glfw.x11.disabledCursorWindow;
@@ -1173,6 +2075,12 @@ static void processEvent(XEvent *event)
                 event->xcookie.evtype == XI_RawMotion)
             {
                 XIRawEvent* re = event->xcookie.data;
+
+                // Raw deltas are unaccelerated and carry no absolute position,
+                // so the pointer has moved by an unknown amount until the
+                // matching MotionNotify or a query refreshes the cache
+                window->x11.cursorPosValid = GLFW_FALSE;
+
                 if (re->valuators.mask_len)
                 {
                     const double* values = re->raw_values;
@@ -1208,6 +2116,20 @@ static void processEvent(XEvent *event)
         handleSelectionRequest(event);
         return;
     }
+    else if (event->type == SelectionNotify &&
+             event->xselection.requestor == _glfw.x11.helperWindowHandle)
+    {
+        handleSelectionNotify(event);
+        return;
+    }
+    else if (event->type == PropertyNotify && handleSelectionTransfer(event))
+        return;
+    else if (event->type == PropertyNotify &&
+             event->xproperty.window == _glfw.x11.helperWindowHandle)
+    {
+        handleClipboardChunk(event);
+        return;
+    }
 
     window = findWindowByHandle(event->xany.window);
     if (window == NULL)
@@ -1434,12 +2356,19 @@ static void processEvent(XEvent *event)
             if (window->cursorMode == GLFW_CURSOR_HIDDEN)
                 _glfwPlatformSetCursorMode(window, GLFW_CURSOR_HIDDEN);
 
+            window->x11.cursorPosX = event->xcrossing.x;
+            window->x11.cursorPosY = event->xcrossing.y;
+            window->x11.cursorPosValid = GLFW_TRUE;
+
             _glfwInputCursorEnter(window, GLFW_TRUE);
             return;
         }
 
         case LeaveNotify:
         {
+            // Motion outside the window is only reported during a grab
+            window->x11.cursorPosValid = GLFW_FALSE;
+
             _glfwInputCursorEnter(window, GLFW_FALSE);
             return;
         }
@@ -1449,6 +2378,10 @@ static void processEvent(XEvent *event)
             const int x = event->xmotion.x;
             const int y = event->xmotion.y;
 
+            window->x11.cursorPosX = x;
+            window->x11.cursorPosY = y;
+            window->x11.cursorPosValid = GLFW_TRUE;
+
             if (x != window->x11.warpCursorPosX ||
                 y != window->x11.warpCursorPosY)
             {
@@ -1479,6 +2412,9 @@ static void processEvent(XEvent *event)
 
         case ConfigureNotify:
         {
+            // Moving the window moves the cursor relative to it
+            window->x11.cursorPosValid = GLFW_FALSE;
+
             if (event->xconfigure.width != window->x11.width ||
                 event->xconfigure.height != window->x11.height)
             {
@@ -1857,6 +2793,25 @@ GLFWbool _glfwIsVisualTransparentX11(Visual* visual)
     return pf && pf->direct.alphaMask;
 }
 
+// Records a swap made by the context so its deadline can be checked when the
+// Present request with the matching serial completes
+//
+void _glfwQueueSwapX11(_GLFWwindow* window, uint64_t sbc,
+                       uint64_t target, int interval)
+{
+    _GLFWswapX11* swap =
+        window->x11.frame.swaps + (uint32_t) sbc % _GLFW_X11_SWAP_QUEUE_SIZE;
+
+    window->x11.frame.sbc = sbc;
+
+    swap->serial = (uint32_t) sbc;
+    swap->valid = target > 0 || interval > 0;
+    swap->target = target;
+    swap->interval = interval;
+    swap->time = (double) (_glfwPlatformGetTimerValue() - _glfw.timer.offset) /
+        _glfwPlatformGetTimerFrequency();
+}
+
 // Push contents of our selection to clipboard manager
 //
 void _glfwPushSelectionToManagerX11(void)
@@ -1884,6 +2839,10 @@ void _glfwPushSelectionToManagerX11(void)
                     handleSelectionClear(&event);
                     break;
 
+                case PropertyNotify:
+                    handleSelectionTransfer(&event);
+                    break;
+
                 case SelectionNotify:
                 {
                     if (event.xselection.target == _glfw.x11.SAVE_TARGETS)
@@ -1918,6 +2877,13 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
     Visual* visual;
     int depth;
 
+    if (wndconfig->x11.softwareSurface && ctxconfig->client != GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "X11: Software surfaces require GLFW_NO_API");
+        return GLFW_FALSE;
+    }
+
     if (ctxconfig->client != GLFW_NO_API)
     {
         if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API)
@@ -1951,6 +2917,12 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
     if (!createNativeWindow(window, wndconfig, visual, depth))
         return GLFW_FALSE;
 
+    if (wndconfig->x11.softwareSurface)
+    {
+        if (!createSoftwareSurface(window, visual, depth))
+            return GLFW_FALSE;
+    }
+
     if (ctxconfig->client != GLFW_NO_API)
     {
         if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API)
@@ -1968,6 +2940,13 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
             if (!_glfwCreateContextOSMesa(window, ctxconfig, fbconfig))
                 return GLFW_FALSE;
         }
+
+        // Frame timing is taken from the presents made by the context
+        if (_glfw.x11.present.available)
+        {
+            XPresentSelectInput(_glfw.x11.display, window->x11.handle,
+                                PresentCompleteNotifyMask);
+        }
     }
 
     if (window->monitor)
@@ -1983,6 +2962,13 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
 
 void _glfwPlatformDestroyWindow(_GLFWwindow* window)
 {
+    if (_glfw.x11.clipboardRequest.window == window)
+    {
+        free(_glfw.x11.clipboardRequest.data);
+        memset(&_glfw.x11.clipboardRequest, 0,
+               sizeof(_glfw.x11.clipboardRequest));
+    }
+
     if (_glfw.x11.disabledCursorWindow == window)
         _glfw.x11.disabledCursorWindow = NULL;
 
@@ -1998,6 +2984,13 @@ void _glfwPlatformDestroyWindow(_GLFWwindow* window)
     if (window->context.destroy)
         window->context.destroy(window);
 
+    if (window->x11.software.enabled)
+    {
+        destroySoftwareBuffers(window);
+        XFreeGC(_glfw.x11.display, window->x11.software.gc);
+        window->x11.software.enabled = GLFW_FALSE;
+    }
+
     if (window->x11.handle)
     {
         XDeleteContext(_glfw.x11.display, window->x11.handle, _glfw.x11.context);
@@ -2617,6 +3610,8 @@ void _glfwPlatformPollEvents(void)
 #if defined(__linux__)
     _glfwDetectJoystickConnectionLinux();
 #endif
+    _glfwDispatchEventSourcesPOSIX();
+
     int count = XPending(_glfw.x11.display);
     while (count--)
     {
@@ -2625,6 +3620,17 @@ void _glfwPlatformPollEvents(void)
         processEvent(&event);
     }
 
+    if (_glfw.x11.transferCount)
+        pruneSelectionTransfers();
+
+    if (_glfw.x11.clipboardRequest.window &&
+        getClipboardRequestTimeLeft() == 0.0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Timed out waiting for clipboard contents");
+        finishClipboardRequest(NULL);
+    }
+
     window = _glfw.x11.disabledCursorWindow;
     if (window)
     {
@@ -2645,52 +3651,46 @@ void _glfwPlatformPollEvents(void)
 
 void _glfwPlatformWaitEvents(void)
 {
-    while (!XPending(_glfw.x11.display))
-        waitForEvent(NULL);
+    // Wake up in time to report a timed out clipboard request
+    if (_glfw.x11.clipboardRequest.window)
+    {
+        double timeout = getClipboardRequestTimeLeft();
+        waitForAnyEvent(&timeout);
+    }
+    else
+        waitForAnyEvent(NULL);
 
     _glfwPlatformPollEvents();
 }
 
 void _glfwPlatformWaitEventsTimeout(double timeout)
 {
-    while (!XPending(_glfw.x11.display))
+    // Wake up in time to report a timed out clipboard request
+    if (_glfw.x11.clipboardRequest.window)
     {
-        if (!waitForEvent(&timeout))
-            break;
+        const double left = getClipboardRequestTimeLeft();
+        if (left < timeout)
+            timeout = left;
     }
 
+    waitForAnyEvent(&timeout);
     _glfwPlatformPollEvents();
 }
 
 void _glfwPlatformPostEmptyEvent(void)
 {
-    XEvent event;
-
-    memset(&event, 0, sizeof(event));
-    event.type = ClientMessage;
-    event.xclient.window = _glfw.x11.helperWindowHandle;
-    event.xclient.format = 32; // Data is 32-bit longs
-    event.xclient.message_type = _glfw.x11.NULL_;
-
-    XSendEvent(_glfw.x11.display, _glfw.x11.helperWindowHandle, False, 0, &event);
-    XFlush(_glfw.x11.display);
+    _glfwPostEmptyEventPOSIX(_glfw.x11.emptyEventPipe);
 }
 
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
 {
-    Window root, child;
-    int rootX, rootY, childX, childY;
-    unsigned int mask;
-
-    XQueryPointer(_glfw.x11.display, window->x11.handle,
-                  &root, &child,
-                  &rootX, &rootY, &childX, &childY,
-                  &mask);
+    if (!window->x11.cursorPosValid)
+        queryCursorPos(window);
 
     if (xpos)
-        *xpos = childX;
+        *xpos = window->x11.cursorPosX;
     if (ypos)
-        *ypos = childY;
+        *ypos = window->x11.cursorPosY;
 }
 
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, double x, double y)
@@ -2702,6 +3702,10 @@ void _glfwPlatformSetCursorPos(_GLFWwindow* window, double x, double y)
     XWarpPointer(_glfw.x11.display, None, window->x11.handle,
                  0,0,0,0, (int) x, (int) y);
     XFlush(_glfw.x11.display);
+
+    // The cache stays valid only if pointer events already keep it current
+    window->x11.cursorPosX = (int) x;
+    window->x11.cursorPosY = (int) y;
 }
 
 void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
@@ -2847,6 +3851,23 @@ const char* _glfwPlatformGetClipboardString(void)
     return getSelectionString(_glfw.x11.CLIPBOARD);
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window,
+                                         GLFWclipboardfun cbfun,
+                                         double timeout)
+{
+    if (_glfw.x11.clipboardRequest.window)
+        finishClipboardRequest(NULL);
+
+    // Even when the clipboard is owned by GLFW, the conversion is handled
+    // through the event loop instead of the server being queried for the owner
+    _glfw.x11.clipboardRequest.window = window;
+    _glfw.x11.clipboardRequest.callback = cbfun;
+    _glfw.x11.clipboardRequest.timeout = timeout;
+    _glfw.x11.clipboardRequest.deadline = getTimerSeconds() + timeout;
+
+    convertClipboardRequest();
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface)
@@ -3014,6 +4035,200 @@ GLFWAPI Window glfwGetX11Window(GLFWwindow* handle)
     return window->x11.handle;
 }
 
+GLFWAPI void glfwQueryX11CursorPos(GLFWwindow* handle,
+                                   double* xpos, double* ypos)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+
+    if (xpos)
+        *xpos = 0;
+    if (ypos)
+        *ypos = 0;
+
+    _GLFW_REQUIRE_INIT();
+
+    queryCursorPos(window);
+
+    if (xpos)
+        *xpos = window->x11.cursorPosX;
+    if (ypos)
+        *ypos = window->x11.cursorPosY;
+}
+
+GLFWAPI int glfwGetX11FrameTiming(GLFWwindow* handle, uint64_t* msc,
+                                  double* time, uint64_t* missed)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (msc)
+        *msc = 0;
+    if (time)
+        *time = 0.0;
+    if (missed)
+        *missed = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!window->x11.frame.count)
+        return GLFW_FALSE;
+
+    if (msc)
+        *msc = window->x11.frame.msc;
+    if (time)
+        *time = window->x11.frame.time;
+    if (missed)
+        *missed = window->x11.frame.missed;
+
+    return GLFW_TRUE;
+}
+
+GLFWAPI void* glfwGetX11SoftwareBuffer(GLFWwindow* handle,
+                                       int* width, int* height, int* stride)
+{
+    _GLFWsoftwareBufferX11* buffer;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (width)
+        *width = 0;
+    if (height)
+        *height = 0;
+    if (stride)
+        *stride = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (!window->x11.software.enabled)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "X11: Window has no software surface");
+        return NULL;
+    }
+
+    if (!acquireSoftwareBuffer(window))
+        return NULL;
+
+    buffer = window->x11.software.buffers + window->x11.software.back;
+
+    if (width)
+        *width = buffer->image->width;
+    if (height)
+        *height = buffer->image->height;
+    if (stride)
+        *stride = buffer->image->bytes_per_line;
+
+    return buffer->image->data;
+}
+
+GLFWAPI int glfwPresentX11SoftwareBuffer(GLFWwindow* handle,
+                                         const int* rects, int count)
+{
+    int i, last = -1;
+    int minX, minY, maxX, maxY;
+    _GLFWsoftwareBufferX11* buffer;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(count >= 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!window->x11.software.enabled)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "X11: Window has no software surface");
+        return GLFW_FALSE;
+    }
+
+    if (!window->x11.software.width || !window->x11.software.height)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "X11: No software surface buffer has been retrieved");
+        return GLFW_FALSE;
+    }
+
+    buffer = window->x11.software.buffers + window->x11.software.back;
+    minX = window->x11.software.width;
+    minY = window->x11.software.height;
+    maxX = 0;
+    maxY = 0;
+
+    if (rects && count)
+    {
+        for (i = 0;  i < count;  i++)
+        {
+            if (getSoftwareRect(window, rects + i * 4, NULL))
+                last = i;
+        }
+    }
+    else
+    {
+        rects = NULL;
+        last = 0;
+    }
+
+    for (i = 0;  i <= last;  i++)
+    {
+        int area[4];
+
+        if (rects)
+        {
+            if (!getSoftwareRect(window, rects + i * 4, area))
+                continue;
+        }
+        else
+        {
+            area[0] = 0;
+            area[1] = 0;
+            area[2] = window->x11.software.width;
+            area[3] = window->x11.software.height;
+        }
+
+        if (buffer->shared)
+        {
+            // Only the last request of the frame needs a completion event, as
+            // the server processes them in order
+            XShmPutImage(_glfw.x11.display, window->x11.handle,
+                         window->x11.software.gc, buffer->image,
+                         area[0], area[1], area[0], area[1],
+                         area[2], area[3],
+                         i == last);
+        }
+        else
+        {
+            XPutImage(_glfw.x11.display, window->x11.handle,
+                      window->x11.software.gc, buffer->image,
+                      area[0], area[1], area[0], area[1],
+                      area[2], area[3]);
+        }
+
+        if (area[0] < minX)
+            minX = area[0];
+        if (area[1] < minY)
+            minY = area[1];
+        if (area[0] + area[2] > maxX)
+            maxX = area[0] + area[2];
+        if (area[1] + area[3] > maxY)
+            maxY = area[1] + area[3];
+    }
+
+    if (last == -1)
+        return GLFW_TRUE;
+
+    if (buffer->shared)
+        buffer->busy = GLFW_TRUE;
+
+    XFlush(_glfw.x11.display);
+
+    // The next back buffer lags behind this frame by the presented area
+    window->x11.software.damageX = minX;
+    window->x11.software.damageY = minY;
+    window->x11.software.damageWidth = maxX - minX;
+    window->x11.software.damageHeight = maxY - minY;
+    window->x11.software.back = !window->x11.software.back;
+    return GLFW_TRUE;
+}
+
 GLFWAPI void glfwSetX11SelectionString(const char* string)
 {
     _GLFW_REQUIRE_INIT();
@@ -51,6 +51,14 @@ static void error_callback(int error, const char* description)
     fprintf(stderr, "Error: %s\n", description);
 }
 
+static void clipboard_callback(GLFWwindow* window, const char* string)
+{
+    if (string)
+        printf("Clipboard request returned \"%s\"\n", string);
+    else
+        printf("Clipboard request returned no string\n");
+}
+
 static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
     if (action != GLFW_PRESS)
@@ -73,6 +81,13 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
                 else
                     printf("Clipboard does not contain a string\n");
             }
+            else if (mods == (MODIFIER | GLFW_MOD_SHIFT))
+            {
+                // The result arrives through the callback during event
+                // processing instead of blocking here
+                glfwRequestClipboardString(window, clipboard_callback, 5.0);
+                printf("Requesting clipboard contents\n");
+            }
             break;
 
         case GLFW_KEY_C:
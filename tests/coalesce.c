@@ -0,0 +1,169 @@
+//========================================================================
+// Event coalescing test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test is intended to verify that event coalescing collapses runs of
+// events of the same kind while keeping the order in which events arrived
+//
+// Move the cursor while scrolling, clicking and resizing the window.  Every
+// callback is logged with a sequential number and the number of cursor
+// positions collapsed into it.  A scroll between two motions must show up
+// between two cursor position callbacks, never after both of them
+//
+// Press C to toggle coalescing and H to toggle the cursor history
+//
+//========================================================================
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static unsigned int counter = 0;
+
+// The kind of the previously delivered event, to point out kind changes
+static const char* last_kind = "";
+
+static void log_event(const char* kind)
+{
+    printf("%08x at %0.3f: %s%s",
+           counter++, glfwGetTime(), kind,
+           last_kind == kind ? "" : " (kind changed)");
+    last_kind = kind;
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void cursor_position_callback(GLFWwindow* window, double x, double y)
+{
+    int count;
+
+    glfwGetCursorHistory(window, &count);
+
+    log_event("Cursor position");
+    printf(": %0.3f %0.3f (%i collapsed)\n", x, y, count);
+}
+
+static void scroll_callback(GLFWwindow* window, double x, double y)
+{
+    log_event("Scroll");
+    printf(": %0.3f %0.3f\n", x, y);
+}
+
+static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
+{
+    log_event("Mouse button");
+    printf(": %i %s\n", button, action == GLFW_PRESS ? "pressed" : "released");
+}
+
+static void window_size_callback(GLFWwindow* window, int width, int height)
+{
+    log_event("Window size");
+    printf(": %i %i\n", width, height);
+}
+
+static void framebuffer_size_callback(GLFWwindow* window, int width, int height)
+{
+    log_event("Framebuffer size");
+    printf(": %i %i\n", width, height);
+
+    glViewport(0, 0, width, height);
+}
+
+static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    if (action != GLFW_PRESS)
+        return;
+
+    switch (key)
+    {
+        case GLFW_KEY_C:
+        {
+            const int value = !glfwGetInputMode(window, GLFW_COALESCE_EVENTS);
+            glfwSetInputMode(window, GLFW_COALESCE_EVENTS, value);
+            printf("Coalescing %s\n", value ? "enabled" : "disabled");
+            break;
+        }
+
+        case GLFW_KEY_H:
+        {
+            const int value = !glfwGetInputMode(window, GLFW_CURSOR_HISTORY);
+            glfwSetInputMode(window, GLFW_CURSOR_HISTORY, value);
+            printf("Cursor history %s\n", value ? "enabled" : "disabled");
+            break;
+        }
+
+        case GLFW_KEY_ESCAPE:
+            glfwSetWindowShouldClose(window, GLFW_TRUE);
+            break;
+    }
+}
+
+int main(void)
+{
+    GLFWwindow* window;
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    window = glfwCreateWindow(640, 480, "Event Coalescing Test", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwMakeContextCurrent(window);
+    gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
+    glfwSwapInterval(1);
+
+    glfwSetInputMode(window, GLFW_COALESCE_EVENTS, GLFW_TRUE);
+    glfwSetInputMode(window, GLFW_CURSOR_HISTORY, GLFW_TRUE);
+
+    glfwSetCursorPosCallback(window, cursor_position_callback);
+    glfwSetScrollCallback(window, scroll_callback);
+    glfwSetMouseButtonCallback(window, mouse_button_callback);
+    glfwSetWindowSizeCallback(window, window_size_callback);
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetKeyCallback(window, key_callback);
+
+    while (!glfwWindowShouldClose(window))
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+        glfwSwapBuffers(window);
+
+        // Events pile up while the swap waits for the vertical blank, so each
+        // processing call has several to collapse
+        glfwPollEvents();
+    }
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
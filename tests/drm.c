@@ -0,0 +1,284 @@
+//========================================================================
+// DRM native access test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test is intended to verify the DRM native access functions
+//
+// By default a full screen window is shown on the primary monitor and the
+// timing of its most recent flip is printed once a second.  Press G to toggle
+// a grayscale color transform and L to toggle a linear degamma ramp
+//
+// With -o a few frames are instead rendered to a headless window and read back
+// through their dma-buf
+//
+//========================================================================
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#define GLFW_EXPOSE_NATIVE_DRM
+#include <GLFW/glfw3native.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "getopt.h"
+
+static int grayscale = GLFW_FALSE;
+static int degamma = GLFW_FALSE;
+
+static void usage(void)
+{
+    printf("Usage: drm [-h] [-o]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -o render to a headless window and read back the frames\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void set_grayscale(GLFWmonitor* monitor, int value)
+{
+    // Rec. 709 luma coefficients in every row
+    const float matrix[9] =
+    {
+        0.2126f, 0.7152f, 0.0722f,
+        0.2126f, 0.7152f, 0.0722f,
+        0.2126f, 0.7152f, 0.0722f
+    };
+
+    if (glfwSetDRMColorTransform(monitor, value ? matrix : NULL))
+        grayscale = value;
+
+    printf("Color transform %s\n", grayscale ? "grayscale" : "disabled");
+}
+
+static void set_degamma(GLFWmonitor* monitor, int value)
+{
+    unsigned short values[256];
+    GLFWgammaramp ramp;
+    int i;
+
+    for (i = 0;  i < 256;  i++)
+        values[i] = (unsigned short) (i * 257);
+
+    ramp.red = ramp.green = ramp.blue = values;
+    ramp.size = 256;
+
+    if (glfwSetDRMDegammaRamp(monitor, value ? &ramp : NULL))
+        degamma = value;
+
+    printf("Degamma ramp %s\n", degamma ? "linear" : "disabled");
+}
+
+static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    if (action != GLFW_PRESS)
+        return;
+
+    switch (key)
+    {
+        case GLFW_KEY_G:
+            set_grayscale(glfwGetWindowMonitor(window), !grayscale);
+            break;
+
+        case GLFW_KEY_L:
+            set_degamma(glfwGetWindowMonitor(window), !degamma);
+            break;
+
+        case GLFW_KEY_ESCAPE:
+            glfwSetWindowShouldClose(window, GLFW_TRUE);
+            break;
+    }
+}
+
+static void list_monitors(void)
+{
+    int i, count;
+    GLFWmonitor** monitors = glfwGetMonitors(&count);
+
+    printf("DRM device file descriptor: %i\n", glfwGetDRMDevice());
+
+    for (i = 0;  i < count;  i++)
+    {
+        printf("Monitor %i (%s): CRTC %u, connector %u\n",
+               i, glfwGetMonitorName(monitors[i]),
+               glfwGetDRMAdapter(monitors[i]),
+               glfwGetDRMMonitor(monitors[i]));
+    }
+}
+
+static int read_back_frames(void)
+{
+    int i;
+    GLFWwindow* window;
+
+    glfwWindowHint(GLFW_DRM_HEADLESS, GLFW_TRUE);
+
+    window = glfwCreateWindow(320, 240, "DRM Headless Test", NULL, NULL);
+    if (!window)
+        return GLFW_FALSE;
+
+    glfwMakeContextCurrent(window);
+    gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
+
+    for (i = 0;  i < 3;  i++)
+    {
+        int fd, width, height;
+        uint32_t format, stride;
+
+        glClearColor(i == 0 ? 1.f : 0.f, i == 1 ? 1.f : 0.f, i == 2 ? 1.f : 0.f, 1.f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glfwSwapBuffers(window);
+
+        if (!glfwGetDRMFrameBuffer(window, &fd, &format, &stride))
+            continue;
+
+        glfwGetFramebufferSize(window, &width, &height);
+
+        {
+            const size_t size = (size_t) stride * height;
+            const unsigned char* pixels =
+                mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+
+            if (pixels != MAP_FAILED)
+            {
+                printf("Frame %i: format %c%c%c%c, stride %u, first pixel %02x%02x%02x%02x\n",
+                       i,
+                       (char) (format & 0xff),
+                       (char) ((format >> 8) & 0xff),
+                       (char) ((format >> 16) & 0xff),
+                       (char) ((format >> 24) & 0xff),
+                       stride,
+                       pixels[3], pixels[2], pixels[1], pixels[0]);
+
+                munmap((void*) pixels, size);
+            }
+            else
+                fprintf(stderr, "Failed to map frame %i\n", i);
+        }
+
+        // The file descriptor is owned by the caller
+        close(fd);
+    }
+
+    glfwDestroyWindow(window);
+    return GLFW_TRUE;
+}
+
+static int show_frames(void)
+{
+    double last_print = 0.0;
+    GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode* mode;
+    GLFWwindow* window;
+
+    if (!monitor)
+        return GLFW_FALSE;
+
+    mode = glfwGetVideoMode(monitor);
+
+    window = glfwCreateWindow(mode->width, mode->height, "DRM Test", monitor, NULL);
+    if (!window)
+        return GLFW_FALSE;
+
+    glfwMakeContextCurrent(window);
+    gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
+    glfwSwapInterval(1);
+
+    glfwSetKeyCallback(window, key_callback);
+
+    while (!glfwWindowShouldClose(window))
+    {
+        const double now = glfwGetTime();
+        const float t = (float) (now - (int) now);
+
+        glClearColor(t, 1.f - t, 0.5f, 1.f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+
+        if (now - last_print >= 1.0)
+        {
+            uint64_t sequence, missed;
+            double time;
+
+            if (glfwGetDRMFrameTiming(window, &sequence, &time, &missed))
+            {
+                printf("Flip: sequence %" PRIu64 " at %0.3f, %" PRIu64 " vblanks missed\n",
+                       sequence, time, missed);
+            }
+
+            last_print = now;
+        }
+    }
+
+    glfwDestroyWindow(window);
+    return GLFW_TRUE;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, result;
+    int headless = GLFW_FALSE;
+
+    while ((ch = getopt(argc, argv, "ho")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'o':
+                headless = GLFW_TRUE;
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    list_monitors();
+
+    if (headless)
+        result = read_back_frames();
+    else
+        result = show_frames();
+
+    glfwTerminate();
+    exit(result ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,177 @@
+//========================================================================
+// File descriptor watching test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test is intended to verify that watched file descriptors wake up and
+// are dispatched by glfwWaitEvents
+//
+// A secondary thread writes a byte to a pipe every second.  Each byte should
+// be logged as soon as it is written, without any other events arriving.
+// Press W to stop or resume watching the pipe
+//
+//========================================================================
+
+#include "tinycthread.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static volatile int running = GLFW_TRUE;
+static int fds[2];
+static int watching = GLFW_FALSE;
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static int thread_main(void* data)
+{
+    struct timespec time;
+    unsigned char byte = 0;
+
+    while (running)
+    {
+        clock_gettime(CLOCK_REALTIME, &time);
+        time.tv_sec += 1;
+        thrd_sleep(&time, NULL);
+
+        if (write(fds[1], &byte, 1) == 1)
+            byte++;
+    }
+
+    return 0;
+}
+
+static void fd_callback(int fd, int events, void* pointer)
+{
+    unsigned char byte;
+
+    if (events & GLFW_FD_READABLE)
+    {
+        // The byte must be consumed or the callback is called again
+        if (read(fd, &byte, 1) == 1)
+            printf("%0.3f: Read byte %u from %s\n", glfwGetTime(), byte, (const char*) pointer);
+    }
+
+    if (events & GLFW_FD_ERROR)
+        printf("%0.3f: Error condition on %s\n", glfwGetTime(), (const char*) pointer);
+}
+
+static void set_watching(int value)
+{
+    if (value)
+        watching = glfwWatchFileDescriptor(fds[0], GLFW_FD_READABLE, fd_callback, "pipe");
+    else
+    {
+        glfwUnwatchFileDescriptor(fds[0]);
+        watching = GLFW_FALSE;
+    }
+
+    printf("%s the pipe\n", watching ? "Watching" : "Not watching");
+}
+
+static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    if (action != GLFW_PRESS)
+        return;
+
+    switch (key)
+    {
+        case GLFW_KEY_W:
+            set_watching(!watching);
+            break;
+
+        case GLFW_KEY_ESCAPE:
+            glfwSetWindowShouldClose(window, GLFW_TRUE);
+            break;
+    }
+}
+
+int main(void)
+{
+    int result;
+    thrd_t thread;
+    GLFWwindow* window;
+
+    glfwSetErrorCallback(error_callback);
+
+    if (pipe(fds) != 0)
+    {
+        fprintf(stderr, "Failed to create pipe\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    window = glfwCreateWindow(640, 480, "File Descriptor Test", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwMakeContextCurrent(window);
+    gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
+    glfwSetKeyCallback(window, key_callback);
+
+    set_watching(GLFW_TRUE);
+
+    if (thrd_create(&thread, thread_main, NULL) != thrd_success)
+    {
+        fprintf(stderr, "Failed to create secondary thread\n");
+
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    while (running)
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+        glfwSwapBuffers(window);
+
+        glfwWaitEvents();
+
+        if (glfwWindowShouldClose(window))
+            running = GLFW_FALSE;
+    }
+
+    // The pipe must not be watched once it is closed
+    set_watching(GLFW_FALSE);
+
+    glfwHideWindow(window);
+    thrd_join(thread, &result);
+    glfwDestroyWindow(window);
+
+    close(fds[0]);
+    close(fds[1]);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,178 @@
+//========================================================================
+// GLX frame timing test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test is intended to verify the X11 and GLX frame timing functions
+//
+// Once a second the timing of the most recent frame, as reported by the
+// Present extension and by GLX_OML_sync_control, is printed along with the
+// cursor position from both the event cache and the X server
+//
+// Press M to toggle between plain and MSC-targeted swaps, D to toggle an
+// artificial delay that should make frames miss their vblank, and W to wait
+// for each targeted swap to complete
+//
+//========================================================================
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#define GLFW_EXPOSE_NATIVE_X11
+#define GLFW_EXPOSE_NATIVE_GLX
+#include <GLFW/glfw3native.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static int targeted = GLFW_FALSE;
+static int delayed = GLFW_FALSE;
+static int waiting = GLFW_FALSE;
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    if (action != GLFW_PRESS)
+        return;
+
+    switch (key)
+    {
+        case GLFW_KEY_M:
+            targeted = !targeted;
+            printf("Swapping %s\n", targeted ? "at target MSCs" : "plainly");
+            break;
+
+        case GLFW_KEY_D:
+            delayed = !delayed;
+            printf("Delay %s\n", delayed ? "enabled" : "disabled");
+            break;
+
+        case GLFW_KEY_W:
+            waiting = !waiting;
+            printf("Waiting for swaps %s\n", waiting ? "enabled" : "disabled");
+            break;
+
+        case GLFW_KEY_ESCAPE:
+            glfwSetWindowShouldClose(window, GLFW_TRUE);
+            break;
+    }
+}
+
+static void print_timing(GLFWwindow* window)
+{
+    uint64_t msc, missed;
+    int64_t ust, oml_msc, sbc;
+    double time, xpos, ypos, xquery, yquery;
+
+    if (glfwGetX11FrameTiming(window, &msc, &time, &missed))
+    {
+        printf("Present: MSC %" PRIu64 " at %0.3f, %" PRIu64 " vblanks missed\n",
+               msc, time, missed);
+    }
+    else
+        printf("Present: No frame has reached the screen\n");
+
+    if (glfwGetGLXSyncValues(window, &ust, &oml_msc, &sbc))
+    {
+        printf("OML: UST %" PRId64 " MSC %" PRId64 " SBC %" PRId64 "\n",
+               ust, oml_msc, sbc);
+    }
+
+    glfwGetCursorPos(window, &xpos, &ypos);
+    glfwQueryX11CursorPos(window, &xquery, &yquery);
+    printf("Cursor: %0.3f %0.3f cached, %0.3f %0.3f queried\n",
+           xpos, ypos, xquery, yquery);
+}
+
+int main(void)
+{
+    int numerator, denominator;
+    double last_print = 0.0;
+    GLFWwindow* window;
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    window = glfwCreateWindow(640, 480, "GLX Frame Timing Test", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwMakeContextCurrent(window);
+    gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
+    glfwSwapInterval(1);
+
+    glfwSetKeyCallback(window, key_callback);
+
+    if (glfwGetGLXMscRate(window, &numerator, &denominator))
+        printf("MSC rate: %0.3f Hz\n", (double) numerator / denominator);
+
+    while (!glfwWindowShouldClose(window))
+    {
+        const double now = glfwGetTime();
+
+        glClearColor((float) (now - (int) now), 0.f, 0.f, 1.f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        if (delayed)
+        {
+            // Spin for long enough to miss at least one vblank at 60 Hz
+            while (glfwGetTime() - now < 0.025)
+                ;
+        }
+
+        if (targeted)
+        {
+            int64_t msc, sbc;
+
+            if (glfwGetGLXSyncValues(window, NULL, &msc, NULL))
+            {
+                sbc = glfwSwapGLXBuffersMsc(window, msc + 1, 0, 0);
+                if (sbc != -1 && waiting)
+                    glfwWaitGLXSwapComplete(window, sbc, NULL, NULL);
+            }
+        }
+        else
+            glfwSwapBuffers(window);
+
+        glfwPollEvents();
+
+        if (now - last_print >= 1.0)
+        {
+            print_timing(window);
+            last_print = now;
+        }
+    }
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}